@@ -0,0 +1,25 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_BENCH_COMMON_H
+#define TIME_MANAGER_BENCH_COMMON_H
+
+#include <stdio.h>
+
+#include "time_manager/utils/time_utils.h"
+
+// Keeps the optimizer from dropping benchmark results
+static volatile double g_bench_sink;
+
+static inline double BenchSeconds(void)
+{
+    return (double)GetHighResolutionTime().nanoseconds / 1000000000.0;
+}
+
+static inline void BenchReport(const char* name, const double iterations, const double seconds, const char* unit)
+{
+    printf("%-44s %14.0f %s/s  (%8.3f ns/op)\n", name, iterations / seconds, unit, seconds * 1e9 / iterations);
+}
+
+#endif //TIME_MANAGER_BENCH_COMMON_H
@@ -0,0 +1,75 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include <stdlib.h>
+
+#include "bench_common.h"
+#include "time_manager/time_manager.h"
+
+static const size_t BENCH_STEPS = 10000000;
+
+static long long g_fake_ns = 0;
+
+static HighResTimeT FakeClock(void)
+{
+    // One 60 Hz step per call, the old way of driving batch runs
+    g_fake_ns += 16666667;
+    return (HighResTimeT){.nanoseconds = g_fake_ns};
+}
+
+static void BenchAdvanceSteps(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    size_t total = 0;
+    const double start = BenchSeconds();
+    for (size_t i = 0; i < BENCH_STEPS; ++i)
+    {
+        total += TmAdvanceSteps(tm, 1).physicsSteps;
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)total;
+    BenchReport("TmAdvanceSteps(1)", (double)total, elapsed, "steps");
+    TmDestroy(tm);
+}
+
+static void BenchAdvanceSimTime(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    const double dt = TmGetPhysicsTimeStep(tm);
+    size_t total = 0;
+    const double start = BenchSeconds();
+    for (size_t i = 0; i < BENCH_STEPS; ++i)
+    {
+        total += TmAdvanceSimTime(tm, dt).physicsSteps;
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)total;
+    BenchReport("TmAdvanceSimTime(dt)", (double)total, elapsed, "steps");
+    TmDestroy(tm);
+}
+
+static void BenchFakeClockBeginFrame(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, FakeClock);
+    (void)TmBeginFrame(tm);
+    size_t total = 0;
+    const double start = BenchSeconds();
+    for (size_t i = 0; i < BENCH_STEPS; ++i)
+    {
+        total += TmBeginFrame(tm).physicsSteps;
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)total;
+    BenchReport("TmBeginFrame with fake clock", (double)total, elapsed, "steps");
+    TmDestroy(tm);
+}
+
+int main(void)
+{
+    BenchAdvanceSteps();
+    BenchAdvanceSimTime();
+    BenchFakeClockBeginFrame();
+    return EXIT_SUCCESS;
+}
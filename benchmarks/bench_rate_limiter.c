@@ -0,0 +1,103 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include <stdlib.h>
+
+#include "bench_common.h"
+#include "time_manager/rate_limiter.h"
+
+static const size_t BENCH_BUCKETS = 50000;
+static const size_t BENCH_TICKS = 200;
+static const double BENCH_RATE = 20.0;
+static const double BENCH_BURST = 5.0;
+
+// The pattern being replaced: every bucket remembers its last refill and reads the clock itself
+typedef struct
+{
+    double tokens;
+    double rate;
+    double burst;
+    long long lastNs;
+} ClockedBucket;
+
+static int ClockedTryConsume(ClockedBucket* bucket)
+{
+    const long long now = GetHighResolutionTime().nanoseconds;
+    const double filled = bucket->tokens + bucket->rate * (double)(now - bucket->lastNs) / 1e9;
+    bucket->tokens = filled < bucket->burst ? filled : bucket->burst;
+    bucket->lastNs = now;
+    if (bucket->tokens < 1.0)
+    {
+        return 0;
+    }
+    bucket->tokens -= 1.0;
+    return 1;
+}
+
+static void BenchPerBucketClock(void)
+{
+    ClockedBucket* buckets = malloc(BENCH_BUCKETS * sizeof *buckets);
+    const long long now = GetHighResolutionTime().nanoseconds;
+    for (size_t i = 0; i < BENCH_BUCKETS; ++i)
+    {
+        buckets[i] = (ClockedBucket){BENCH_BURST, BENCH_RATE, BENCH_BURST, now};
+    }
+
+    size_t accepted = 0;
+    const double start = BenchSeconds();
+    for (size_t tick = 0; tick < BENCH_TICKS; ++tick)
+    {
+        for (size_t i = 0; i < BENCH_BUCKETS; ++i)
+        {
+            accepted += (size_t)ClockedTryConsume(&buckets[i]);
+        }
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)accepted;
+    BenchReport("per-bucket clock read + consume", (double)(BENCH_BUCKETS * BENCH_TICKS), elapsed, "buckets");
+    free(buckets);
+}
+
+static void BenchBulkRefill(void)
+{
+    TmRateLimiter* rl = TmRateLimiterCreate(BENCH_BUCKETS, BENCH_RATE, BENCH_BURST);
+    const double dt = 1.0 / 60.0;
+
+    size_t accepted = 0;
+    const double start = BenchSeconds();
+    for (size_t tick = 0; tick < BENCH_TICKS; ++tick)
+    {
+        TmRateLimiterRefill(rl, dt);
+        for (size_t i = 0; i < BENCH_BUCKETS; ++i)
+        {
+            accepted += TmRateLimiterTryConsume(rl, i, 1.0) ? 1 : 0;
+        }
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)accepted;
+    BenchReport("TmRateLimiterRefill + TryConsume", (double)(BENCH_BUCKETS * BENCH_TICKS), elapsed, "buckets");
+    TmRateLimiterDestroy(rl);
+}
+
+static void BenchRefillOnly(void)
+{
+    TmRateLimiter* rl = TmRateLimiterCreate(BENCH_BUCKETS, BENCH_RATE, BENCH_BURST);
+    const double start = BenchSeconds();
+    for (size_t tick = 0; tick < BENCH_TICKS; ++tick)
+    {
+        TmRateLimiterRefill(rl, 1.0 / 60.0);
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = TmRateLimiterTokens(rl, 0);
+    BenchReport("TmRateLimiterRefill", (double)(BENCH_BUCKETS * BENCH_TICKS), elapsed, "buckets");
+    TmRateLimiterDestroy(rl);
+}
+
+int main(void)
+{
+    BenchPerBucketClock();
+    BenchBulkRefill();
+    BenchRefillOnly();
+    return EXIT_SUCCESS;
+}
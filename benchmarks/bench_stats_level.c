@@ -0,0 +1,72 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include <stdlib.h>
+
+#include "bench_common.h"
+#include "time_manager/time_manager.h"
+
+static const size_t BENCH_FRAMES = 2000000;
+
+static const char* const LEVEL_NAMES[] = {"NONE", "BASIC", "HISTOGRAM", "TRACING"};
+
+static long long g_fake_ns = 0;
+
+// A 60 Hz clock, so the benchmark measures the bookkeeping rather than the OS clock
+static HighResTimeT FakeNow(void)
+{
+    g_fake_ns += 16666667;
+    return (HighResTimeT){g_fake_ns};
+}
+
+static void BenchBeginFrame(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, FakeNow);
+
+    size_t steps = 0;
+    const double start = BenchSeconds();
+    for (size_t frame = 0; frame < BENCH_FRAMES; ++frame)
+    {
+        steps += TmBeginFrame(tm).physicsSteps;
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)steps;
+
+    char name[64];
+    snprintf(name, sizeof name, "TmBeginFrame, stats level %s", LEVEL_NAMES[TM_STATS_LEVEL]);
+    BenchReport(name, (double)BENCH_FRAMES, elapsed, "frames");
+    TmDestroy(tm);
+}
+
+static void BenchBeginFrameWithPhases(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, FakeNow);
+
+    size_t steps = 0;
+    const double start = BenchSeconds();
+    for (size_t frame = 0; frame < BENCH_FRAMES; ++frame)
+    {
+        steps += TmBeginFrame(tm).physicsSteps;
+        TmPhaseBegin(tm, TM_PHASE_SIM);
+        TmPhaseEnd(tm, TM_PHASE_SIM);
+        TmPhaseBegin(tm, TM_PHASE_RENDER_SUBMIT);
+        TmPhaseEnd(tm, TM_PHASE_RENDER_SUBMIT);
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)steps;
+
+    char name[64];
+    snprintf(name, sizeof name, "  + two phases, stats level %s", LEVEL_NAMES[TM_STATS_LEVEL]);
+    BenchReport(name, (double)BENCH_FRAMES, elapsed, "frames");
+    TmDestroy(tm);
+}
+
+int main(void)
+{
+    BenchBeginFrame();
+    BenchBeginFrameWithPhases();
+    return EXIT_SUCCESS;
+}
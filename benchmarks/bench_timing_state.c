@@ -0,0 +1,52 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include <stdlib.h>
+
+#include "bench_common.h"
+#include "time_manager/time_manager.h"
+
+static const size_t BENCH_ITERATIONS = 20000000;
+
+static void BenchSaveRestore(TimeManager* tm)
+{
+    TmTimingState state;
+    const double start = BenchSeconds();
+    for (size_t i = 0; i < BENCH_ITERATIONS; ++i)
+    {
+        TmSaveTimingState(tm, &state);
+        state.accumulator += 1e-9;
+        TmRestoreTimingState(tm, &state);
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = TmGetAccumulator(tm);
+    BenchReport("TmSaveTimingState + TmRestoreTimingState", (double)BENCH_ITERATIONS, elapsed, "pairs");
+}
+
+static void BenchSerializeRoundTrip(TimeManager* tm)
+{
+    TmTimingState state;
+    TmSaveTimingState(tm, &state);
+    unsigned char buffer[TM_TIMING_STATE_SERIALIZED_SIZE];
+    size_t ok = 0;
+    const double start = BenchSeconds();
+    for (size_t i = 0; i < BENCH_ITERATIONS; ++i)
+    {
+        (void)TmSerializeTimingState(&state, buffer, sizeof buffer);
+        ok += TmDeserializeTimingState(&state, buffer, sizeof buffer);
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)ok + state.accumulator;
+    BenchReport("TmSerialize + TmDeserializeTimingState", (double)BENCH_ITERATIONS, elapsed, "round trips");
+}
+
+int main(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    (void)TmAdvanceSimTime(tm, 0.01);
+    BenchSaveRestore(tm);
+    BenchSerializeRoundTrip(tm);
+    TmDestroy(tm);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include <stdlib.h>
+
+#include "bench_common.h"
+#include "time_manager/trace_exporter.h"
+
+static const size_t BENCH_FRAMES = 200000;
+static const char* BENCH_TRACE_PATH = "bench_trace_exporter.json";
+
+static long long g_fake_ns = 0;
+
+// A 60 Hz clock, so the benchmark measures the bookkeeping rather than the OS clock
+static HighResTimeT FakeNow(void)
+{
+    g_fake_ns += 8333333;
+    return (HighResTimeT){g_fake_ns};
+}
+
+static void BenchFrames(const char* name, TmTraceExporter* exporter)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, FakeNow);
+    TmAttachTraceExporter(tm, exporter);
+
+    size_t steps = 0;
+    const double start = BenchSeconds();
+    for (size_t frame = 0; frame < BENCH_FRAMES; ++frame)
+    {
+        steps += TmBeginFrame(tm).physicsSteps;
+        TmPhaseBegin(tm, TM_PHASE_SIM);
+        TmPhaseEnd(tm, TM_PHASE_SIM);
+    }
+    const double elapsed = BenchSeconds() - start;
+    g_bench_sink = (double)steps;
+    BenchReport(name, (double)BENCH_FRAMES, elapsed, "frames");
+
+    TmAttachTraceExporter(tm, NULL);
+    TmDestroy(tm);
+}
+
+int main(void)
+{
+    BenchFrames("TmBeginFrame + phase, no exporter", NULL);
+
+    TmTraceExporterConfig cfg = TmTraceExporterDefaultConfig(BENCH_TRACE_PATH);
+    cfg.capacity = 1u << 16;
+    cfg.flushInterval = 5;
+    TmTraceExporter* exporter = TmTraceExporterCreate(&cfg);
+    if (!exporter)
+    {
+        return EXIT_FAILURE;
+    }
+    BenchFrames("TmBeginFrame + phase, exporter attached", exporter);
+    const TmTraceStats stats = TmTraceExporterGetStats(exporter);
+    printf("  recorded %zu, dropped %zu\n", stats.recorded, stats.dropped);
+    TmTraceExporterDestroy(exporter);
+    remove(BENCH_TRACE_PATH);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,264 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_FLIGHT_RECORDER_H
+#define TIME_MANAGER_FLIGHT_RECORDER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "time_manager/perf_counters.h"
+#include "time_manager/thread_usage.h"
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+/** Size in bytes of the header of a dump written by TmFlightRecorderDump. */
+#define TM_FLIGHT_RECORDER_HEADER_SIZE 24
+/** Size in bytes of each frame record in a dump. */
+#define TM_FLIGHT_RECORD_SERIALIZED_SIZE 180
+
+static const size_t DEFAULT_FLIGHT_RECORDER_CAPACITY = 600;
+static const double DEFAULT_HITCH_SPIKE_FACTOR = 2.0;
+static const double DEFAULT_HITCH_MIN_SPIKE = 0.005; // seconds
+static const size_t DEFAULT_SUSTAINED_LAG_FRAMES = 30;
+static const size_t DEFAULT_POST_TRIGGER_FRAMES = 30;
+
+/**
+ * @brief Fixed-size recorder of recent frames with an online hitch classifier.
+ *
+ * Attached to a TimeManager, it records every TmBeginFrame result, the frame's phase times, and
+ * the hardware counters and thread usage of any attached TmPerfCounters and TmThreadUsage into a
+ * preallocated ring, so a slow frame shows whether it was compute, waiting or faults. Each frame is
+ * classified against a running baseline; when a triggering event is seen the recorder captures a
+ * few more frames for context, then freezes so the frames around the event can be dumped to a
+ * buffer or file in a compact binary format.
+ */
+typedef struct TmFlightRecorder TmFlightRecorder;
+
+typedef enum
+{
+    /** Nothing unusual. */
+    TM_HITCH_NONE = 0,
+    /** An isolated frame time spike. */
+    TM_HITCH_SINGLE = 1,
+    /** Spikes recurring at a regular frame interval, e.g. a periodic task or GC. */
+    TM_HITCH_PERIODIC = 2,
+    /** The simulation has been lagging for sustainedLagFrames frames in a row. */
+    TM_HITCH_SUSTAINED_LAG = 3
+} TmHitchKind;
+
+typedef struct
+{
+    /** Frames recorded since creation, starting at 0. */
+    uint64_t frameIndex;
+    /** Clock time the frame started at (see TmGetFrameStartTime). */
+    int64_t startNs;
+    /** FrameTimingData.tick. */
+    uint64_t tick;
+    /** FrameTimingData.rawFrameTime. */
+    double rawFrameTime;
+    /** FrameTimingData.frameTime. */
+    double frameTime;
+    /** FrameTimingData.droppedTime. */
+    double droppedTime;
+    /** FrameTimingData.presentInterval. */
+    double presentInterval;
+    /** FrameTimingData.physicsSteps. */
+    uint32_t physicsSteps;
+    /** FrameTimingData.lagging. */
+    bool lagging;
+    /** FrameTimingData.phaseBudgetExceeded. */
+    uint32_t phaseBudgetExceeded;
+    /** How the detector classified this frame. */
+    TmHitchKind hitch;
+    /** Time of each TmFramePhase in the frame, in seconds. */
+    double phaseTimes[TM_PHASE_COUNT];
+    /** TmPerfFrameCounters.available of the frame; 0 without TmPerfCounters attached to the TimeManager. */
+    uint32_t perfAvailable;
+    /** TmPerfFrameCounters.values of the frame, indexed by TmPerfCounter. */
+    uint64_t perfCounters[TM_PERF_COUNTER_COUNT];
+    /** TmThreadFrameUsage.cpuTime of the frame; 0 without TmThreadUsage attached to the TimeManager. */
+    double threadCpuTime;
+    /** TmThreadFrameUsage.waitTime of the frame. */
+    double threadWaitTime;
+    /** TmThreadFrameUsage.minorFaults of the frame. */
+    uint64_t minorFaults;
+    /** TmThreadFrameUsage.majorFaults of the frame. */
+    uint64_t majorFaults;
+} TmFlightRecord;
+
+/**
+ * @brief Called once the recorder has frozen after a trigger.
+ *
+ * @param userData The pointer from the configuration.
+ * @param recorder The frozen recorder, e.g. to dump it.
+ * @param kind The event that triggered it.
+ */
+typedef void (*TmFlightTriggerFn)(void* userData, TmFlightRecorder* recorder, TmHitchKind kind);
+
+typedef struct
+{
+    /** Frames kept. Must be > 0. */
+    size_t capacity;
+    /** A frame is a spike when its raw time exceeds the baseline by this factor... Must be > 1. */
+    double spikeFactor;
+    /** ...and by at least this many seconds. */
+    double minSpike;
+    /** Consecutive lagging frames that count as sustained lag. Must be > 0. */
+    size_t sustainedLagFrames;
+    /** Frames recorded after a trigger before freezing. */
+    size_t postTriggerFrames;
+    /** Bit (1u << kind) for each TmHitchKind that freezes the recorder. */
+    uint32_t triggerMask;
+    /** Optional callback when the recorder freezes. */
+    TmFlightTriggerFn onTrigger;
+    /** Pointer passed to onTrigger. */
+    void* userData;
+} TmFlightRecorderConfig;
+
+typedef struct
+{
+    /** Frames classified as TM_HITCH_SINGLE. */
+    size_t singleHitches;
+    /** Frames classified as TM_HITCH_PERIODIC. */
+    size_t periodicHitches;
+    /** Sustained lag episodes. */
+    size_t sustainedLags;
+    /** Running baseline of the raw frame time, in seconds. */
+    double baselineFrameTime;
+} TmHitchStats;
+
+static inline TmFlightRecorderConfig TmFlightRecorderDefaultConfig(void)
+{
+    return (TmFlightRecorderConfig){
+        .capacity = DEFAULT_FLIGHT_RECORDER_CAPACITY,
+        .spikeFactor = DEFAULT_HITCH_SPIKE_FACTOR,
+        .minSpike = DEFAULT_HITCH_MIN_SPIKE,
+        .sustainedLagFrames = DEFAULT_SUSTAINED_LAG_FRAMES,
+        .postTriggerFrames = DEFAULT_POST_TRIGGER_FRAMES,
+        .triggerMask = (1u << TM_HITCH_SINGLE) | (1u << TM_HITCH_PERIODIC) | (1u << TM_HITCH_SUSTAINED_LAG),
+        .onTrigger = NULL,
+        .userData = NULL
+    };
+}
+
+/**
+ * @brief Creates a flight recorder. All memory is allocated up front.
+ *
+ * @param config Recorder configuration. Must not be null.
+ * @return The new recorder, or null if the configuration is invalid or allocation fails.
+ */
+TIME_MANAGER_API TmFlightRecorder* TmFlightRecorderCreate(const TmFlightRecorderConfig* config);
+
+/**
+ * @brief Frees a flight recorder. Detach it from any TimeManager first.
+ *
+ * @param recorder The recorder to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmFlightRecorderDestroy(TmFlightRecorder* recorder);
+
+/**
+ * @brief Attaches a flight recorder so every TmBeginFrame is recorded.
+ *
+ * Frames are only fed to it when the library is built with TM_STATS_TRACING.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param recorder The recorder to attach, or null to detach.
+ */
+TIME_MANAGER_API void TmAttachFlightRecorder(TimeManager* tm, TmFlightRecorder* recorder);
+
+/**
+ * @brief Records and classifies a frame. Called by TmBeginFrame when attached.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ * @param tm The TimeManager the frame came from. Must not be null.
+ * @param frame The TmBeginFrame result. Must not be null.
+ * @return Classification of the frame.
+ */
+TIME_MANAGER_API TmHitchKind TmFlightRecorderRecord(TmFlightRecorder* recorder, const TimeManager* tm,
+                                                    const FrameTimingData* frame);
+
+/**
+ * @brief Checks whether the recorder has frozen after a trigger.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ * @return True while frozen.
+ */
+TIME_MANAGER_API bool TmFlightRecorderIsFrozen(const TmFlightRecorder* recorder);
+
+/**
+ * @brief Resumes recording after a freeze. Recorded frames are kept until overwritten.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ */
+TIME_MANAGER_API void TmFlightRecorderRearm(TmFlightRecorder* recorder);
+
+/**
+ * @brief Retrieves the number of frames held.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ * @return Frames available through TmFlightRecorderGet, at most the capacity.
+ */
+TIME_MANAGER_API size_t TmFlightRecorderCount(const TmFlightRecorder* recorder);
+
+/**
+ * @brief Retrieves a recorded frame.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ * @param index Index from 0 (oldest) to TmFlightRecorderCount - 1 (newest).
+ * @param record Receives the frame. Must not be null.
+ * @return False if index is out of range.
+ */
+TIME_MANAGER_API bool TmFlightRecorderGet(const TmFlightRecorder* recorder, size_t index, TmFlightRecord* record);
+
+/**
+ * @brief Retrieves hitch counters and the baseline frame time.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ * @return Counts of each event kind since creation.
+ */
+TIME_MANAGER_API TmHitchStats TmFlightRecorderGetStats(const TmFlightRecorder* recorder);
+
+/**
+ * @brief Retrieves the size of a dump of the current contents.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ * @return TM_FLIGHT_RECORDER_HEADER_SIZE + count * TM_FLIGHT_RECORD_SERIALIZED_SIZE.
+ */
+TIME_MANAGER_API size_t TmFlightRecorderDumpSize(const TmFlightRecorder* recorder);
+
+/**
+ * @brief Writes the recorded frames, oldest first, into a buffer.
+ *
+ * The format is little-endian and independent of the host: a header with the magic "TMFR", a
+ * version, the trigger kind, the record count, the record size and the frame index of the trigger,
+ * followed by fixed-size records holding the TmFlightRecord fields in declaration order.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ * @param buffer Destination buffer.
+ * @param bufferSize Size of buffer in bytes.
+ * @return Bytes written, or 0 if buffer is null or smaller than TmFlightRecorderDumpSize.
+ */
+TIME_MANAGER_API size_t TmFlightRecorderDump(const TmFlightRecorder* recorder, void* buffer, size_t bufferSize);
+
+/**
+ * @brief Writes the same dump as TmFlightRecorderDump to a file, without allocating.
+ *
+ * @param recorder Pointer to the recorder. Must not be null.
+ * @param path File to create or overwrite. Must not be null.
+ * @return True if the whole dump was written.
+ */
+TIME_MANAGER_API bool TmFlightRecorderDumpToFile(const TmFlightRecorder* recorder, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_FLIGHT_RECORDER_H
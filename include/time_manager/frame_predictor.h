@@ -0,0 +1,128 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_FRAME_PREDICTOR_H
+#define TIME_MANAGER_FRAME_PREDICTOR_H
+
+#include <stddef.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+static const double DEFAULT_PREDICTOR_PERCENTILE = 0.95;
+static const double DEFAULT_PREDICTOR_MIN_SCALE = 0.5;
+static const double DEFAULT_PREDICTOR_MAX_SCALE = 1.0;
+static const double DEFAULT_PREDICTOR_QUALITY_EXPONENT = 2.0;
+static const double DEFAULT_PREDICTOR_SMOOTHING = 0.1;
+static const double DEFAULT_PREDICTOR_MAX_SCALE_STEP = 0.05;
+
+/**
+ * @brief Predicts the next frame's cost and picks a quality scale that keeps it within budget.
+ *
+ * Frame costs are normalized by the quality scale they were rendered at (cost is modeled as
+ * proportional to scale^qualityExponent, e.g. pixel count for a resolution scale) and tracked as an
+ * exponentially weighted mean and variance. The predicted cost at the configured percentile is the
+ * mean plus the matching number of standard deviations, and the controller moves the scale towards
+ * the largest one whose prediction fits the target frame time, a bounded step per frame.
+ */
+typedef struct TmFramePredictor TmFramePredictor;
+
+typedef struct
+{
+    /** Frame time budget in seconds. Must be > 0. */
+    double targetFrameTime;
+    /** Fraction of frames that should fit the budget, in [0.5, 1). */
+    double percentile;
+    /** Lowest quality scale the controller may pick. Must be > 0. */
+    double minScale;
+    /** Highest quality scale the controller may pick. Must be >= minScale. */
+    double maxScale;
+    /** Exponent of the cost model cost ~ scale^exponent, 2 for a per-axis resolution scale. Must be > 0. */
+    double qualityExponent;
+    /** Weight of each new frame in the mean and variance, in (0, 1]. */
+    double smoothing;
+    /** Largest relative scale change per frame, e.g. 0.05 for 5%. Must be > 0. */
+    double maxScaleStep;
+} TmFramePredictorConfig;
+
+typedef struct
+{
+    /** Expected cost of the next frame at the current quality scale, in seconds. */
+    double expected;
+    /** Cost the next frame stays under with the configured percentile, in seconds. */
+    double upperBound;
+    /** Standard deviation of the frame cost at the current quality scale, in seconds. */
+    double stddev;
+    /** Quality scale to render the next frame at. */
+    double qualityScale;
+} TmFramePrediction;
+
+static inline TmFramePredictorConfig TmFramePredictorDefaultConfig(const double targetFrameTime)
+{
+    return (TmFramePredictorConfig){
+        .targetFrameTime = targetFrameTime,
+        .percentile = DEFAULT_PREDICTOR_PERCENTILE,
+        .minScale = DEFAULT_PREDICTOR_MIN_SCALE,
+        .maxScale = DEFAULT_PREDICTOR_MAX_SCALE,
+        .qualityExponent = DEFAULT_PREDICTOR_QUALITY_EXPONENT,
+        .smoothing = DEFAULT_PREDICTOR_SMOOTHING,
+        .maxScaleStep = DEFAULT_PREDICTOR_MAX_SCALE_STEP
+    };
+}
+
+/**
+ * @brief Creates a frame predictor starting at the maximum quality scale.
+ *
+ * @param config Predictor configuration. Must not be null.
+ * @return The new predictor, or null if the configuration is invalid or allocation fails.
+ */
+TIME_MANAGER_API TmFramePredictor* TmFramePredictorCreate(const TmFramePredictorConfig* config);
+
+/**
+ * @brief Frees a frame predictor.
+ *
+ * @param predictor The predictor to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmFramePredictorDestroy(TmFramePredictor* predictor);
+
+/**
+ * @brief Feeds the cost of a frame rendered at the current quality scale and updates the scale.
+ *
+ * @param predictor Pointer to the predictor. Must not be null.
+ * @param frameCost Time the frame's work took in seconds. Values <= 0 are ignored.
+ */
+TIME_MANAGER_API void TmFramePredictorObserve(TmFramePredictor* predictor, double frameCost);
+
+/**
+ * @brief Feeds the frame that just ended from the TimeManager's measurements.
+ *
+ * Uses the sum of the last frame's phase times, excluding TM_PHASE_PRESENT so vsync waits are not
+ * counted as work, when phases are marked; otherwise the frame's rawFrameTime.
+ *
+ * @param predictor Pointer to the predictor. Must not be null.
+ * @param tm The TimeManager the frame came from. Must not be null.
+ * @param frame The result of the latest TmBeginFrame. Must not be null.
+ * @return The frame cost that was observed, in seconds.
+ */
+TIME_MANAGER_API double TmFramePredictorObserveFrame(TmFramePredictor* predictor, const TimeManager* tm,
+                                                     const FrameTimingData* frame);
+
+/**
+ * @brief Retrieves the prediction for the next frame.
+ *
+ * @param predictor Pointer to the predictor. Must not be null.
+ * @return Expected cost, percentile bound and quality scale for the next frame.
+ */
+TIME_MANAGER_API TmFramePrediction TmFramePredictorPredict(const TmFramePredictor* predictor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_FRAME_PREDICTOR_H
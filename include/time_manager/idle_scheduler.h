@@ -0,0 +1,130 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_IDLE_SCHEDULER_H
+#define TIME_MANAGER_IDLE_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+static const size_t DEFAULT_IDLE_TASK_CAPACITY = 256;
+static const double DEFAULT_IDLE_MARGIN = 0.001; // seconds
+
+/**
+ * @brief Queue of background tasks run in the time left over at the end of a frame.
+ *
+ * Tasks run until a margin before the next frame's deadline (frame start plus the target frame
+ * time). Each task's duration is measured and learned per task function, and a task whose
+ * estimated cost does not fit the remaining time is left queued for a later frame instead of
+ * overrunning. Tasks should be small slices of work, e.g. one chunk of decompression.
+ */
+typedef struct TmIdleScheduler TmIdleScheduler;
+
+/**
+ * @brief A background task.
+ *
+ * @param userData The pointer posted with the task.
+ */
+typedef void (*TmIdleTaskFn)(void* userData);
+
+typedef struct
+{
+    /** Tasks run since creation. */
+    size_t tasksRun;
+    /** Times a task was left queued because its estimate did not fit the remaining time. */
+    size_t tasksDeferred;
+    /** Tasks that ran past the deadline. */
+    size_t overruns;
+    /** Total time spent running tasks, in seconds. */
+    double timeUsed;
+    /** Idle time that was available at the start of the last TmIdleSchedulerRun, in seconds. */
+    double lastBudget;
+} TmIdleSchedulerStats;
+
+/**
+ * @brief Creates an idle scheduler. All storage is allocated up front.
+ *
+ * @param capacity Maximum number of queued tasks, e.g. DEFAULT_IDLE_TASK_CAPACITY. Must be > 0.
+ * @param targetFrameTime Frame time being paced to in seconds, e.g. 1.0 / 60.0. Must be > 0.
+ * @param margin Time in seconds to leave unused before the deadline, e.g. DEFAULT_IDLE_MARGIN. Must be >= 0.
+ * @return The new scheduler, or null if the arguments are invalid or allocation fails.
+ */
+TIME_MANAGER_API TmIdleScheduler* TmIdleSchedulerCreate(size_t capacity, double targetFrameTime, double margin);
+
+/**
+ * @brief Frees an idle scheduler. Queued tasks are dropped without running.
+ *
+ * @param scheduler The scheduler to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmIdleSchedulerDestroy(TmIdleScheduler* scheduler);
+
+/**
+ * @brief Changes the frame deadline the scheduler works towards.
+ *
+ * @param scheduler Pointer to the scheduler. Must not be null.
+ * @param targetFrameTime Frame time being paced to in seconds. Must be > 0.
+ * @param margin Time in seconds to leave unused before the deadline. Must be >= 0.
+ */
+TIME_MANAGER_API void TmIdleSchedulerSetBudget(TmIdleScheduler* scheduler, double targetFrameTime, double margin);
+
+/**
+ * @brief Queues a task. Tasks may post further tasks while running.
+ *
+ * @param scheduler Pointer to the scheduler. Must not be null.
+ * @param taskFn The task to run. Must not be null.
+ * @param userData Pointer passed to taskFn.
+ * @return False if the queue is full.
+ */
+TIME_MANAGER_API bool TmIdleSchedulerPost(TmIdleScheduler* scheduler, TmIdleTaskFn taskFn, void* userData);
+
+/**
+ * @brief Runs queued tasks in the time left in the current frame.
+ *
+ * Call after rendering, before waiting for the next frame. Tasks run in posting order, skipping any
+ * whose estimated cost exceeds the remaining time; tasks posted while running wait for the next call.
+ *
+ * @param scheduler Pointer to the scheduler. Must not be null.
+ * @param tm TimeManager whose frame start and clock define the deadline. Must not be null.
+ * @return Number of tasks run.
+ */
+TIME_MANAGER_API size_t TmIdleSchedulerRun(TmIdleScheduler* scheduler, const TimeManager* tm);
+
+/**
+ * @brief Retrieves the number of queued tasks.
+ *
+ * @param scheduler Pointer to the scheduler. Must not be null.
+ * @return Tasks waiting to run.
+ */
+TIME_MANAGER_API size_t TmIdleSchedulerPending(const TmIdleScheduler* scheduler);
+
+/**
+ * @brief Retrieves the learned cost of a task function.
+ *
+ * @param scheduler Pointer to the scheduler. Must not be null.
+ * @param taskFn The task function.
+ * @return Estimated duration in seconds, with headroom for variance; 0 if it has not run yet.
+ */
+TIME_MANAGER_API double TmIdleSchedulerEstimate(const TmIdleScheduler* scheduler, TmIdleTaskFn taskFn);
+
+/**
+ * @brief Retrieves scheduling statistics.
+ *
+ * @param scheduler Pointer to the scheduler. Must not be null.
+ * @return Counters since creation.
+ */
+TIME_MANAGER_API TmIdleSchedulerStats TmIdleSchedulerGetStats(const TmIdleScheduler* scheduler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_IDLE_SCHEDULER_H
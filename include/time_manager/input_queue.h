@@ -0,0 +1,107 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_INPUT_QUEUE_H
+#define TIME_MANAGER_INPUT_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+/**
+ * @brief Lock-free queue of timestamped events from any number of threads to the sim thread.
+ *
+ * Producers (input, network receive) push fixed-size events that are stamped with the current
+ * time; the sim thread dispatches them per fixed step, each event on the step its timestamp maps
+ * to (see TmMapTimestampToTick), in timestamp order. All storage is allocated at creation, so
+ * pushing and dispatching never allocate or lock.
+ */
+typedef struct TmInputQueue TmInputQueue;
+
+/**
+ * @brief Callback receiving one dispatched event.
+ *
+ * @param userData The pointer passed to TmInputQueueDispatch.
+ * @param event The event bytes, valid only during the call.
+ * @param timestamp The time the event was stamped with.
+ * @param tick The step the timestamp maps to; earlier than the dispatched tick if the event arrived late.
+ */
+typedef void (*TmInputFn)(void* userData, const void* event, HighResTimeT timestamp, uint64_t tick);
+
+/**
+ * @brief Creates an input queue.
+ *
+ * @param capacity Events that can be in flight at once, rounded up to a power of two.
+ * @param eventSize Size of each event in bytes. Must be > 0.
+ * @param nowFn Clock used to stamp events; pass the TimeManager's time source so timestamps map to
+ *              its ticks. Null uses GetHighResolutionTime.
+ * @return The new queue, or null if the arguments are invalid or allocation fails.
+ */
+TIME_MANAGER_API TmInputQueue* TmInputQueueCreate(size_t capacity, size_t eventSize, HighResTimeT (*nowFn)(void));
+
+/**
+ * @brief Frees an input queue. No thread may be using it.
+ *
+ * @param queue The queue to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmInputQueueDestroy(TmInputQueue* queue);
+
+/**
+ * @brief Pushes an event stamped with the current time. Safe to call from any thread.
+ *
+ * @param queue Pointer to the queue. Must not be null.
+ * @param event eventSize bytes to copy. Must not be null.
+ * @return False if the queue is full and the event was not queued.
+ */
+TIME_MANAGER_API bool TmInputQueuePush(TmInputQueue* queue, const void* event);
+
+/**
+ * @brief Pushes an event with an explicit timestamp, e.g. one provided by the OS. Safe to call from any thread.
+ *
+ * @param queue Pointer to the queue. Must not be null.
+ * @param event eventSize bytes to copy. Must not be null.
+ * @param timestamp Time the event happened, on the queue's clock.
+ * @return False if the queue is full and the event was not queued.
+ */
+TIME_MANAGER_API bool TmInputQueuePushAt(TmInputQueue* queue, const void* event, HighResTimeT timestamp);
+
+/**
+ * @brief Dispatches every queued event due for a fixed step, in timestamp order. Sim thread only.
+ *
+ * Call once per step before simulating it, e.g. with FrameTimingData.tick + i for the i-th step of
+ * a frame. Events that map to later steps stay queued for their own step.
+ *
+ * @param queue Pointer to the queue. Must not be null.
+ * @param tm TimeManager the timestamps are mapped with. Must not be null.
+ * @param tick The step about to run.
+ * @param eventFn Callback receiving each event. Must not be null.
+ * @param userData Pointer passed through to eventFn.
+ * @return Number of events dispatched.
+ */
+TIME_MANAGER_API size_t TmInputQueueDispatch(TmInputQueue* queue, const TimeManager* tm, uint64_t tick,
+                                             TmInputFn eventFn, void* userData);
+
+/**
+ * @brief Retrieves the number of events received but not yet dispatched. Sim thread only.
+ *
+ * Events still in flight from producers are not counted until the next dispatch collects them.
+ *
+ * @param queue Pointer to the queue. Must not be null.
+ * @return Number of events waiting for a later step.
+ */
+TIME_MANAGER_API size_t TmInputQueuePending(const TmInputQueue* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_INPUT_QUEUE_H
@@ -0,0 +1,157 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_JITTER_BUFFER_H
+#define TIME_MANAGER_JITTER_BUFFER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+static const size_t DEFAULT_JITTER_BUFFER_CAPACITY = 64;
+static const size_t DEFAULT_JITTER_WINDOW = 64;
+static const double DEFAULT_JITTER_PERCENTILE = 0.95;
+static const double DEFAULT_JITTER_MIN_DELAY = 0.005;
+static const double DEFAULT_JITTER_MAX_DELAY = 0.5;
+static const double DEFAULT_JITTER_MAX_RATE_ADJUST = 0.05;
+
+/**
+ * @brief Adaptive jitter buffer for server snapshots.
+ *
+ * Snapshots are keyed by server tick and stamped with their arrival time on the local clock.
+ * The buffer measures transit jitter, derives a playback delay from a jitter percentile, and
+ * plays back along a smoothly time-warped clock that converges on that delay without jumps or
+ * stalls, so the interpolation delay stays as low as the network allows.
+ */
+typedef struct TmJitterBuffer TmJitterBuffer;
+
+typedef struct
+{
+    /** Snapshots retained, keyed by server tick. */
+    size_t capacity;
+    /** Size of each snapshot in bytes. Must be > 0. */
+    size_t recordSize;
+    /** Server tick rate in Hz, used to place ticks on the server timeline. Must be > 0. */
+    double serverTickRate;
+    /** Jitter percentile the playback delay covers, in (0, 1]. */
+    double percentile;
+    /** Number of recent arrivals the jitter percentile is measured over. */
+    size_t windowSize;
+    /** Safety margin in seconds on top of the snapshot interval, used when jitter is smaller. */
+    double minDelay;
+    /** Upper bound of the playback delay in seconds. */
+    double maxDelay;
+    /** Largest playback speed change, e.g. 0.05 plays back between 0.95x and 1.05x. */
+    double maxRateAdjust;
+} TmJitterBufferConfig;
+
+typedef struct
+{
+    /** Snapshot at or before the playback time. */
+    const void* from;
+    /** Snapshot after the playback time; equal to from when holding the newest snapshot. */
+    const void* to;
+    /** Server tick of from. */
+    uint64_t fromTick;
+    /** Server tick of to. */
+    uint64_t toTick;
+    /** Interpolation factor in [0, 1] from from towards to. */
+    double alpha;
+    /** Current playback delay in seconds behind the fastest observed transit. */
+    double delay;
+    /** Delay the playback clock is converging on, in seconds. */
+    double targetDelay;
+    /** True if playback ran past the newest snapshot and is holding it. */
+    bool underrun;
+} TmJitterSample;
+
+typedef struct
+{
+    /** Snapshots accepted by TmJitterBufferPush. */
+    size_t received;
+    /** Snapshots that arrived after playback had already passed their tick. */
+    size_t late;
+    /** Samples that ran past the newest snapshot. */
+    size_t underruns;
+    /** Transit jitter at the configured percentile, in seconds. */
+    double jitter;
+    /** Estimated interval between consecutive snapshots, in seconds. */
+    double snapshotInterval;
+} TmJitterBufferStats;
+
+static inline TmJitterBufferConfig TmJitterBufferDefaultConfig(const size_t recordSize, const double serverTickRate)
+{
+    return (TmJitterBufferConfig){
+        .capacity = DEFAULT_JITTER_BUFFER_CAPACITY,
+        .recordSize = recordSize,
+        .serverTickRate = serverTickRate,
+        .percentile = DEFAULT_JITTER_PERCENTILE,
+        .windowSize = DEFAULT_JITTER_WINDOW,
+        .minDelay = DEFAULT_JITTER_MIN_DELAY,
+        .maxDelay = DEFAULT_JITTER_MAX_DELAY,
+        .maxRateAdjust = DEFAULT_JITTER_MAX_RATE_ADJUST
+    };
+}
+
+/**
+ * @brief Creates a jitter buffer. All memory is allocated up front.
+ *
+ * @param config Buffer configuration. Must not be null.
+ * @return The new jitter buffer, or null if the configuration is invalid or allocation fails.
+ */
+TIME_MANAGER_API TmJitterBuffer* TmJitterBufferCreate(const TmJitterBufferConfig* config);
+
+/**
+ * @brief Frees a jitter buffer.
+ *
+ * @param buffer The buffer to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmJitterBufferDestroy(TmJitterBuffer* buffer);
+
+/**
+ * @brief Adds a server snapshot.
+ *
+ * Snapshots may arrive out of order or not at all; each one updates the jitter estimate.
+ *
+ * @param buffer Pointer to the buffer. Must not be null.
+ * @param serverTick Server tick the snapshot was taken on.
+ * @param arrival Arrival time on the local clock, e.g. TmNow of the client's TimeManager.
+ * @param snapshot recordSize bytes to copy. Must not be null.
+ */
+TIME_MANAGER_API void TmJitterBufferPush(TmJitterBuffer* buffer, uint64_t serverTick, HighResTimeT arrival,
+                                         const void* snapshot);
+
+/**
+ * @brief Advances the playback clock to now and returns the snapshots to interpolate.
+ *
+ * Call once per rendered frame with a non-decreasing time from the same clock as the arrivals.
+ *
+ * @param buffer Pointer to the buffer. Must not be null.
+ * @param now Current time on the local clock.
+ * @param sample Receives the bracketing snapshots and delay information. Must not be null.
+ * @return False until two snapshots have been pushed and the snapshot interval is known.
+ */
+TIME_MANAGER_API bool TmJitterBufferSample(TmJitterBuffer* buffer, HighResTimeT now, TmJitterSample* sample);
+
+/**
+ * @brief Retrieves arrival and playback statistics.
+ *
+ * @param buffer Pointer to the buffer. Must not be null.
+ * @return Counters and the current jitter estimate.
+ */
+TIME_MANAGER_API TmJitterBufferStats TmJitterBufferGetStats(const TmJitterBuffer* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_JITTER_BUFFER_H
@@ -0,0 +1,150 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_LAG_ATTRIBUTION_H
+#define TIME_MANAGER_LAG_ATTRIBUTION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+/**
+ * @brief Splits the time lost in lagging frames between cgroup throttling, hypervisor steal and
+ * everything else (Linux).
+ *
+ * It reads throttled_usec and nr_throttled from the process's cgroup v2 cpu.stat and the steal
+ * column of /proc/stat, keeping the files open and re-reading them with pread. The sources are
+ * only read on frames that lag and, as a baseline refresh, on the first frame after
+ * refreshInterval of wall time without one; other frames cost nothing. Each read covers the
+ * window since the previous one. For a lagging frame, the window's throttled time and stolen
+ * fraction are charged to the frame first, the frame's wall time is divided into throttled time,
+ * stolen time and the rest, and its droppedTime is charged to each cause in proportion.
+ *
+ * The granularity is coarse: throttled_usec is in microseconds, but steal is counted in clock
+ * ticks (USER_HZ, usually 10ms), so steal within a single 60Hz frame is mostly noise and only
+ * becomes meaningful over longer windows and repeated lag.
+ *
+ * Both sources are approximations of what one thread saw: the kernel sums throttled time over
+ * the cgroup's CPUs, so it is capped at the frame time, and steal is the machine-wide stolen
+ * fraction of CPU time applied to the frame. Sources that are missing (cgroup v1, no cpu
+ * controller, other platforms) read as zero and the lost time goes to "other".
+ */
+typedef struct TmLagAttribution TmLagAttribution;
+
+typedef struct
+{
+    /** cgroup v2 cpu.stat to read, or null to find the process's own cgroup. */
+    const char* cpuStatPath;
+    /** /proc/stat or a replacement, or null for /proc/stat. */
+    const char* procStatPath;
+    /** Wall time between baseline reads when no frame lags, in seconds. Zero reads every frame. */
+    double refreshInterval;
+} TmLagAttributionConfig;
+
+typedef struct
+{
+    /** Wall time of the frame, in seconds. */
+    double frameTime;
+    /** Whether the sources were read for this frame; otherwise throttledTime and stealTime are zero. */
+    bool sampled;
+    /** Part of frameTime the cgroup was throttled. */
+    double throttledTime;
+    /** Part of frameTime the hypervisor ran something else. */
+    double stealTime;
+    /** Whether the frame lagged; only lagging frames are charged in the statistics. */
+    bool lagging;
+    /** FrameTimingData.droppedTime. */
+    double lostTime;
+    /** lostTime charged to throttling. */
+    double lostToThrottling;
+    /** lostTime charged to steal. */
+    double lostToSteal;
+    /** lostTime charged to everything else: own work, blocking, the rest of the system. */
+    double lostToOther;
+} TmLagFrameAttribution;
+
+typedef struct
+{
+    /** Frames recorded. */
+    size_t frames;
+    /** Frames that lagged. */
+    size_t lagFrames;
+    /** Throttled and stolen time over all frames, in seconds. */
+    double throttledTime;
+    double stealTime;
+    /** Throttling periods (cpu.stat nr_throttled) over all frames. */
+    uint64_t throttledPeriods;
+    /** Lost time of lagging frames, in total and per cause. */
+    double lostTime;
+    double lostToThrottling;
+    double lostToSteal;
+    double lostToOther;
+    /** Whether cpu.stat with throttling counters was found. */
+    bool hasThrottling;
+    /** Whether /proc/stat with a steal column was found. */
+    bool hasSteal;
+} TmLagAttributionStats;
+
+static inline TmLagAttributionConfig TmLagAttributionDefaultConfig(void)
+{
+    return (TmLagAttributionConfig){.cpuStatPath = NULL, .procStatPath = NULL, .refreshInterval = 1.0};
+}
+
+/**
+ * @brief Opens the sources and takes the first reading.
+ *
+ * @param config Configuration, or null for the defaults.
+ * @return The attribution, or null if allocation fails. Missing sources do not make it fail.
+ */
+TIME_MANAGER_API TmLagAttribution* TmLagAttributionCreate(const TmLagAttributionConfig* config);
+
+/**
+ * @brief Closes the sources. Detach it from any TimeManager first.
+ *
+ * @param attribution The attribution to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmLagAttributionDestroy(TmLagAttribution* attribution);
+
+/**
+ * @brief Attributes the frame, reading the sources if it lagged or the baseline is due for a
+ * refresh. Called by TmBeginFrame when attached.
+ *
+ * @param attribution Pointer to the attribution. Must not be null.
+ * @param frame The TmBeginFrame result. Must not be null.
+ * @return How the frame's time divides between the causes.
+ */
+TIME_MANAGER_API TmLagFrameAttribution TmLagAttributionRecord(TmLagAttribution* attribution,
+                                                              const FrameTimingData* frame);
+
+/**
+ * @brief Retrieves the totals since creation.
+ *
+ * @param attribution Pointer to the attribution. Must not be null.
+ * @return Throttled and stolen time and the lost time of lagging frames per cause.
+ */
+TIME_MANAGER_API TmLagAttributionStats TmLagAttributionGetStats(const TmLagAttribution* attribution);
+
+/**
+ * @brief Attaches lag attribution so every TmBeginFrame is recorded.
+ *
+ * Frames are only recorded when the library is built with TM_STATS_TRACING.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param attribution The attribution to attach, or null to detach.
+ */
+TIME_MANAGER_API void TmAttachLagAttribution(TimeManager* tm, TmLagAttribution* attribution);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_LAG_ATTRIBUTION_H
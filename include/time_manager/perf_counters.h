@@ -0,0 +1,121 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_PERF_COUNTERS_H
+#define TIME_MANAGER_PERF_COUNTERS_H
+
+#include <stdint.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+/**
+ * @brief Per-frame hardware performance counters for one thread (Linux perf_event_open).
+ *
+ * Opens cycles, instructions, last-level cache misses and context switches as one perf event
+ * group on the calling thread, so they are scheduled together and read with a single syscall.
+ * Counters the kernel refuses (no PMU in a container or VM, perf_event_paranoid, seccomp) are
+ * left out; on other platforms none are available. Creating the counters never fails because of
+ * that: check TmPerfCountersAvailable or the available mask of each sample.
+ */
+typedef struct TmPerfCounters TmPerfCounters;
+
+typedef enum
+{
+    TM_PERF_CYCLES = 0,
+    TM_PERF_INSTRUCTIONS,
+    /** Last-level cache misses. */
+    TM_PERF_LLC_MISSES,
+    TM_PERF_CONTEXT_SWITCHES,
+
+    TM_PERF_COUNTER_COUNT
+} TmPerfCounter;
+
+typedef struct
+{
+    /** Counts over the frame, indexed by TmPerfCounter; 0 for unavailable counters. */
+    uint64_t values[TM_PERF_COUNTER_COUNT];
+    /** Bit (1u << counter) for each counter with a value. 0 if nothing could be read. */
+    uint32_t available;
+    /** Instructions per cycle, or 0 if either is unavailable. */
+    double instructionsPerCycle;
+    /**
+     * Fraction of the frame the group was actually on the PMU. Below 1 the kernel multiplexed it
+     * with other events and the values are scaled estimates.
+     */
+    double running;
+} TmPerfFrameCounters;
+
+/**
+ * @brief Opens the counters for the calling thread and starts them.
+ *
+ * Call it on the thread whose frames are measured, normally the one calling TmBeginFrame.
+ *
+ * @return The counters, or null if allocation fails. Unavailable counters do not make it fail.
+ */
+TIME_MANAGER_API TmPerfCounters* TmPerfCountersCreate(void);
+
+/**
+ * @brief Closes the counters. Detach them from any TimeManager first.
+ *
+ * @param counters The counters to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmPerfCountersDestroy(TmPerfCounters* counters);
+
+/**
+ * @brief Retrieves the counters that could be opened.
+ *
+ * @param counters Pointer to the counters. Must not be null.
+ * @return Bit (1u << counter) for each available TmPerfCounter.
+ */
+TIME_MANAGER_API uint32_t TmPerfCountersAvailable(const TmPerfCounters* counters);
+
+/**
+ * @brief Reads the group and returns the counts since the previous sample (or since creation).
+ *
+ * Called by TmBeginFrame when attached, making each sample cover one frame. Costs one read()
+ * syscall when any counter is available and nothing otherwise.
+ *
+ * @param counters Pointer to the counters. Must not be null.
+ * @return The deltas, also kept for TmPerfCountersGetFrame.
+ */
+TIME_MANAGER_API TmPerfFrameCounters TmPerfCountersSample(TmPerfCounters* counters);
+
+/**
+ * @brief Retrieves the most recent sample.
+ *
+ * @param counters Pointer to the counters. Must not be null.
+ * @return The last TmPerfCountersSample result, zeroed before the first one.
+ */
+TIME_MANAGER_API TmPerfFrameCounters TmPerfCountersGetFrame(const TmPerfCounters* counters);
+
+/**
+ * @brief Attaches counters so every TmBeginFrame samples them.
+ *
+ * Samples are only taken when the library is built with TM_STATS_TRACING. A flight recorder
+ * attached to the same TimeManager stores each frame's sample in its records.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param counters The counters to attach, or null to detach.
+ */
+TIME_MANAGER_API void TmAttachPerfCounters(TimeManager* tm, TmPerfCounters* counters);
+
+/**
+ * @brief Retrieves the attached counters.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return The counters passed to TmAttachPerfCounters, or null if none are attached.
+ */
+TIME_MANAGER_API TmPerfCounters* TmGetPerfCounters(const TimeManager* tm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_PERF_COUNTERS_H
@@ -0,0 +1,106 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_RATE_LIMITER_H
+#define TIME_MANAGER_RATE_LIMITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+/**
+ * @brief A set of token buckets refilled together from one clock sample.
+ *
+ * Buckets are stored as parallel arrays, so refilling tens of thousands of them is one linear pass
+ * with no clock reads. Drive it from the frame: refill with the time TmBeginFrame already measured,
+ * e.g. physicsSteps * fixedTimestep for per-step game actions or unscaledFrameTime for network sends.
+ * Tokens are consumed with the same floating-point tolerance the accumulator uses for whole steps,
+ * so ten refills of a tenth of a token make exactly one.
+ */
+typedef struct TmRateLimiter TmRateLimiter;
+
+/**
+ * @brief Creates a rate limiter with every bucket full.
+ *
+ * @param bucketCount Number of buckets. Must be > 0.
+ * @param rate Default refill rate in tokens per second. Must be >= 0.
+ * @param burst Default bucket size in tokens. Must be > 0.
+ * @return The new rate limiter, or null if the arguments are invalid or allocation fails.
+ */
+TIME_MANAGER_API TmRateLimiter* TmRateLimiterCreate(size_t bucketCount, double rate, double burst);
+
+/**
+ * @brief Frees a rate limiter.
+ *
+ * @param limiter The limiter to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmRateLimiterDestroy(TmRateLimiter* limiter);
+
+/**
+ * @brief Retrieves the number of buckets.
+ *
+ * @param limiter Pointer to the limiter. Must not be null.
+ * @return The bucket count given at creation.
+ */
+TIME_MANAGER_API size_t TmRateLimiterBucketCount(const TmRateLimiter* limiter);
+
+/**
+ * @brief Changes one bucket's rate and size, e.g. for a connection with a different send budget.
+ *
+ * Tokens above the new size are discarded.
+ *
+ * @param limiter Pointer to the limiter. Must not be null.
+ * @param bucket Index of the bucket.
+ * @param rate Refill rate in tokens per second. Must be >= 0.
+ * @param burst Bucket size in tokens. Must be > 0.
+ */
+TIME_MANAGER_API void TmRateLimiterSetBucket(TmRateLimiter* limiter, size_t bucket, double rate, double burst);
+
+/**
+ * @brief Refills a bucket to its full size, e.g. when a slot is reused for a new connection.
+ *
+ * @param limiter Pointer to the limiter. Must not be null.
+ * @param bucket Index of the bucket.
+ */
+TIME_MANAGER_API void TmRateLimiterResetBucket(TmRateLimiter* limiter, size_t bucket);
+
+/**
+ * @brief Refills every bucket for the elapsed time.
+ *
+ * @param limiter Pointer to the limiter. Must not be null.
+ * @param elapsed Time since the last refill in seconds. Negative values are ignored.
+ */
+TIME_MANAGER_API void TmRateLimiterRefill(TmRateLimiter* limiter, double elapsed);
+
+/**
+ * @brief Takes tokens from a bucket if it holds enough.
+ *
+ * @param limiter Pointer to the limiter. Must not be null.
+ * @param bucket Index of the bucket.
+ * @param tokens Number of tokens the action costs.
+ * @return True if the tokens were taken, false if the action should be throttled.
+ */
+TIME_MANAGER_API bool TmRateLimiterTryConsume(TmRateLimiter* limiter, size_t bucket, double tokens);
+
+/**
+ * @brief Retrieves the tokens currently in a bucket.
+ *
+ * @param limiter Pointer to the limiter. Must not be null.
+ * @param bucket Index of the bucket.
+ * @return Tokens available, between 0 and the bucket size.
+ */
+TIME_MANAGER_API double TmRateLimiterTokens(const TmRateLimiter* limiter, size_t bucket);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_RATE_LIMITER_H
@@ -0,0 +1,119 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_THREAD_USAGE_H
+#define TIME_MANAGER_THREAD_USAGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+/**
+ * @brief Per-frame CPU time, wait time, page faults and context switches of the frame thread.
+ *
+ * Each sample splits the frame's wall time into CPU time the thread actually ran
+ * (CLOCK_THREAD_CPUTIME_ID, GetThreadTimes on Windows) and time it waited: blocked, sleeping or
+ * runnable but descheduled. On Linux getrusage(RUSAGE_THREAD) adds minor/major faults and
+ * voluntary/involuntary context switches; elsewhere those read as zero and hasFaults is false.
+ * Samples must be taken on the thread being measured.
+ */
+typedef struct TmThreadUsage TmThreadUsage;
+
+typedef struct
+{
+    /** Wall time the sample covers, in seconds. */
+    double wallTime;
+    /** CPU time the thread used, in seconds. Windows updates it once per scheduler tick. */
+    double cpuTime;
+    /** wallTime - cpuTime, at least 0. */
+    double waitTime;
+    /** Page faults served without I/O. */
+    uint64_t minorFaults;
+    /** Page faults that had to read from disk. */
+    uint64_t majorFaults;
+    /** Times the thread gave up the CPU, usually to block or sleep. */
+    uint64_t voluntarySwitches;
+    /** Times the thread was preempted. */
+    uint64_t involuntarySwitches;
+    /** False where the fault and context switch fields are not available or could not be read. */
+    bool hasFaults;
+} TmThreadFrameUsage;
+
+/**
+ * @brief Creates usage accounting and takes the first reading on the calling thread.
+ *
+ * @return The accounting, or null if allocation fails.
+ */
+TIME_MANAGER_API TmThreadUsage* TmThreadUsageCreate(void);
+
+/**
+ * @brief Frees usage accounting. Detach it from any TimeManager first.
+ *
+ * @param usage The accounting to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmThreadUsageDestroy(TmThreadUsage* usage);
+
+/**
+ * @brief Reads the thread's counters and returns the usage since the previous sample.
+ *
+ * Called by TmBeginFrame with the raw frame time when attached, making each sample cover one
+ * frame.
+ *
+ * @param usage Pointer to the accounting. Must not be null.
+ * @param wallTime Wall time since the previous sample, in seconds.
+ * @return The usage, also kept for TmThreadUsageGetFrame.
+ */
+TIME_MANAGER_API TmThreadFrameUsage TmThreadUsageSample(TmThreadUsage* usage, double wallTime);
+
+/**
+ * @brief Makes the next sample only take a new baseline, reporting zeros.
+ *
+ * Counts since the previous reading are discarded. Does not read the thread, so it may be called
+ * from any thread.
+ *
+ * @param usage Pointer to the accounting. Must not be null.
+ */
+TIME_MANAGER_API void TmThreadUsageRestart(TmThreadUsage* usage);
+
+/**
+ * @brief Retrieves the most recent sample.
+ *
+ * @param usage Pointer to the accounting. Must not be null.
+ * @return The last TmThreadUsageSample result, zeroed before the first one.
+ */
+TIME_MANAGER_API TmThreadFrameUsage TmThreadUsageGetFrame(const TmThreadUsage* usage);
+
+/**
+ * @brief Attaches usage accounting so every TmBeginFrame samples it.
+ *
+ * Samples are only taken when the library is built with TM_STATS_TRACING. Attaching restarts the
+ * accounting, so the first frame only takes a baseline and every reported sample covers exactly
+ * one frame instead of the time since creation. A flight recorder attached to the same
+ * TimeManager stores each frame's sample in its records.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param usage The accounting to attach, or null to detach.
+ */
+TIME_MANAGER_API void TmAttachThreadUsage(TimeManager* tm, TmThreadUsage* usage);
+
+/**
+ * @brief Retrieves the attached usage accounting.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return The accounting passed to TmAttachThreadUsage, or null if none is attached.
+ */
+TIME_MANAGER_API TmThreadUsage* TmGetThreadUsage(const TimeManager* tm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_THREAD_USAGE_H
@@ -0,0 +1,124 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_TICK_HISTORY_H
+#define TIME_MANAGER_TICK_HISTORY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+/**
+ * @brief Fixed-size, tick-indexed history of caller-sized records.
+ *
+ * Stores one record per tick in a power-of-two ring, contiguously and without per-record
+ * allocation, for lag compensation and other rewinds. Ticks are the TimeManager's ticks, so a
+ * record written for tick k holds the state after k fixed steps.
+ */
+typedef struct TmTickHistory TmTickHistory;
+
+typedef struct
+{
+    /** Record at or before the sampled time. */
+    const void* from;
+    /** Record after the sampled time; equal to from when the time is exactly on a tick. */
+    const void* to;
+    /** Tick of from. */
+    uint64_t fromTick;
+    /** Tick of to. */
+    uint64_t toTick;
+    /** Interpolation factor in [0, 1) from from towards to. */
+    double alpha;
+} TmHistorySample;
+
+/**
+ * @brief Creates a tick history.
+ *
+ * @param capacity Number of ticks to retain, rounded up to a power of two. Must be > 0.
+ * @param recordSize Size of each record in bytes. Must be > 0.
+ * @return The new history, or null if the arguments are invalid or memory allocation fails.
+ */
+TIME_MANAGER_API TmTickHistory* TmTickHistoryCreate(size_t capacity, size_t recordSize);
+
+/**
+ * @brief Frees a tick history.
+ *
+ * @param history The history to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmTickHistoryDestroy(TmTickHistory* history);
+
+/**
+ * @brief Returns the slot for a tick's record, claiming it for that tick.
+ *
+ * The record previously stored in the slot, capacity ticks earlier, is evicted. The caller
+ * writes recordSize bytes into the returned memory, which is suitably aligned for any type.
+ *
+ * @param history Pointer to the history. Must not be null.
+ * @param tick Tick the record belongs to.
+ * @return Pointer to the record's storage.
+ */
+TIME_MANAGER_API void* TmTickHistoryWrite(TmTickHistory* history, uint64_t tick);
+
+/**
+ * @brief Copies a record into the history for a tick.
+ *
+ * @param history Pointer to the history. Must not be null.
+ * @param tick Tick the record belongs to.
+ * @param record recordSize bytes to copy. Must not be null.
+ */
+TIME_MANAGER_API void TmTickHistoryPush(TmTickHistory* history, uint64_t tick, const void* record);
+
+/**
+ * @brief Looks up the record of a tick in O(1).
+ *
+ * @param history Pointer to the history. Must not be null.
+ * @param tick The tick to look up.
+ * @return The record, or null if the tick was never written or has been evicted.
+ */
+TIME_MANAGER_API const void* TmTickHistoryGet(const TmTickHistory* history, uint64_t tick);
+
+/**
+ * @brief Finds the records bracketing a past simulation time and the factor between them.
+ *
+ * Converts the time to a tick with TmGetTickAtSimTime, e.g. the time a client rendered when the
+ * shot was fired, and looks up that tick and the next one in O(1).
+ *
+ * @param history Pointer to the history. Must not be null.
+ * @param tm TimeManager whose ticks key the history. Must not be null.
+ * @param simTimeNs Simulation time in nanoseconds to sample.
+ * @param sample Receives the bracketing records. Must not be null.
+ * @return True if both records are available (or the time lies exactly on an available tick).
+ */
+TIME_MANAGER_API bool TmTickHistorySample(const TmTickHistory* history, const TimeManager* tm, int64_t simTimeNs,
+                                          TmHistorySample* sample);
+
+/**
+ * @brief Retrieves the number of ticks the history retains.
+ *
+ * @param history Pointer to the history. Must not be null.
+ * @return The capacity after rounding to a power of two.
+ */
+TIME_MANAGER_API size_t TmTickHistoryCapacity(const TmTickHistory* history);
+
+/**
+ * @brief Retrieves the record size the history was created with.
+ *
+ * @param history Pointer to the history. Must not be null.
+ * @return Record size in bytes.
+ */
+TIME_MANAGER_API size_t TmTickHistoryRecordSize(const TmTickHistory* history);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_TICK_HISTORY_H
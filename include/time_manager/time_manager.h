@@ -8,9 +8,11 @@
 #include <stdbool.h>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <stddef.h>
+#include <stdint.h>
 
 #include "time_manager/time_manager_export.h"
 
+#include "utils/extrapolate.h"
 #include "utils/time_utils.h"
 
 // @formatter:off
@@ -23,9 +25,59 @@ static const size_t DEFAULT_PHYSICS_HZ = 60;
 static const double DEFAULT_MAX_FRAME_TIME = 0.25;
 static const size_t DEFAULT_MAX_PHYSICS_STEPS = 5;
 static const double DEFAULT_TIME_SCALE = 1.0;
+static const size_t DEFAULT_FAST_FORWARD_CHUNK = 1024;
+static const size_t DEFAULT_MAX_SUBSTEPS = 8;
+static const double DEFAULT_MAX_EXTRAPOLATION_ALPHA = 2.0;
+
+/** Statistics levels for TM_STATS_LEVEL, each including the ones below it. */
+#define TM_STATS_NONE 0
+#define TM_STATS_BASIC 1
+#define TM_STATS_HISTOGRAM 2
+#define TM_STATS_TRACING 3
+
+/**
+ * Statistics compiled into the library, set with the TIME_MANAGER_STATS_LEVEL CMake option.
+ *
+ * - TM_STATS_NONE: TmBeginFrame only does the timing math. Average FPS and phase tracking compile
+ *   out, TmPhaseBegin/TmPhaseEnd do not read the clock and the getters return zeros.
+ * - TM_STATS_BASIC: average FPS, last phase times with budgets.
+ * - TM_STATS_HISTOGRAM: also the rolling phase windows behind TmPhaseStats average and max.
+ * - TM_STATS_TRACING: also feeds attached flight recorders, trace exporters, perf counters, thread
+ *   usage accounting and lag attribution, and the USDT probes.
+ */
+#ifndef TM_STATS_LEVEL
+#define TM_STATS_LEVEL TM_STATS_TRACING
+#endif
+
+/** Size in bytes of a TmTimingState serialized with TmSerializeTimingState. */
+#define TM_TIMING_STATE_SERIALIZED_SIZE 88
 
 typedef struct TimeManager TimeManager;
 
+typedef enum
+{
+    /** Render between the previous and latest step; interpolationAlpha stays in [0, 1]. */
+    TM_RENDER_INTERPOLATE = 0,
+    /** Render past the latest step at the current time; interpolationAlpha is >= 1. */
+    TM_RENDER_EXTRAPOLATE = 1
+} TmRenderMode;
+
+typedef enum
+{
+    /** Polling and handling input. */
+    TM_PHASE_INPUT = 0,
+    /** Fixed-step simulation. */
+    TM_PHASE_SIM,
+    /** Animation and other per-frame updates. */
+    TM_PHASE_ANIMATION,
+    /** Building and submitting render commands. */
+    TM_PHASE_RENDER_SUBMIT,
+    /** Presenting, including any wait for the swap chain. */
+    TM_PHASE_PRESENT,
+    /** Number of phases. */
+    TM_PHASE_COUNT
+} TmFramePhase;
+
 typedef struct
 {
     size_t physicsHz;
@@ -72,6 +124,9 @@ typedef struct
      * Range: [0.0, 1.0] where 0.0 indicates the previous state (before the
      * next physics step) and 1.0 indicates the current state (at the next
      * physics step).
+     *
+     * In TM_RENDER_EXTRAPOLATE mode the range is [1.0, maxExtrapolationAlpha]: the
+     * render time lies past the latest state, and alpha - 1.0 is how many steps past it.
      */
     double interpolationAlpha;
     /**
@@ -125,8 +180,301 @@ typedef struct
      * down the simulation. A value of 0.0 effectively pauses the simulation.
      */
     double currentTimeScale;
+    /**
+     * Wall-clock time in seconds that this frame discarded instead of simulating.
+     *
+     * This is the part of rawFrameTime cut off by maxFrameTime plus the accumulated time thrown
+     * away when the step count was clamped to maxPhysicsSteps. Passing it to TmFastForward
+     * simulates the lost time in batches instead of dropping it.
+     */
+    double droppedTime;
+    /**
+     * Simulation time in seconds that the render time lies past the latest completed step.
+     *
+     * Zero in TM_RENDER_INTERPOLATE mode. In TM_RENDER_EXTRAPOLATE mode this is the time to
+     * dead-reckon the latest state forward by, e.g. with TmExtrapolatePositions.
+     */
+    double extrapolationTime;
+    /**
+     * Tick index of the first fixed step of this frame.
+     *
+     * Ticks count fixed steps over the lifetime of the TimeManager: tick k is the simulation
+     * state after k steps. This frame's steps advance the simulation from tick to
+     * tick + physicsSteps, so step i runs on tick + i.
+     */
+    uint64_t tick;
+    /**
+     * Simulation time in nanoseconds of the latest completed step, tick + physicsSteps.
+     *
+     * Exact and drift-free: it is derived from the tick count and the timestep rather than
+     * accumulated from frame times, and follows the timescale since steps consume scaled time.
+     */
+    int64_t simTimeNs;
+    /**
+     * Total unscaled (capped) wall-clock time in nanoseconds fed into the simulation so far.
+     *
+     * Time in droppedTime is not included until it is passed to TmFastForward.
+     */
+    int64_t unscaledTimeNs;
+    /**
+     * Phases that went over their budget in the frame this TmBeginFrame ended.
+     *
+     * Bit (1u << phase) is set for each TmFramePhase whose time between the previous TmBeginFrame
+     * and this one exceeded the budget set with TmSetPhaseBudget. Zero if no phases are marked.
+     */
+    uint32_t phaseBudgetExceeded;
+    /**
+     * Time in seconds between the two latest presents marked with TmMarkPresent.
+     *
+     * Unlike rawFrameTime, which measures TmBeginFrame to TmBeginFrame, this is the cadence the
+     * display actually showed frames at once the swap chain queues them. Zero until two presents.
+     */
+    double presentInterval;
+    /**
+     * Refresh periods presentInterval spans, rounded; 0 if no refresh period is set.
+     *
+     * With a swap interval of 1 anything above 1 means the previous image was repeated.
+     */
+    size_t presentRefreshes;
 } FrameTimingData;
 
+typedef struct
+{
+    /**
+     * Interpolation factor at the latched timestamp, same range and meaning as
+     * FrameTimingData::interpolationAlpha for the active render mode.
+     */
+    double interpolationAlpha;
+    /**
+     * Simulation time in seconds the render time lies past the latest completed step, zero in
+     * TM_RENDER_INTERPOLATE mode. Same meaning as FrameTimingData::extrapolationTime.
+     */
+    double extrapolationTime;
+    /**
+     * Scaled simulation time in seconds between the latest completed step and the timestamp,
+     * i.e. the accumulator as it would be at that time. Not clamped by the render mode.
+     */
+    double simTimeSinceStep;
+    /**
+     * Wall-clock seconds between the start of the current frame and the timestamp.
+     */
+    double timeSinceFrame;
+    /**
+     * Absolute simulation time in nanoseconds at the timestamp, on the same clock as
+     * FrameTimingData::simTimeNs.
+     */
+    int64_t simTimeNs;
+} TmLatchedTiming;
+
+/**
+ * @brief Plain-data snapshot of the simulation-relevant timing state of a TimeManager.
+ *
+ * Captures everything that determines which fixed steps future frames produce: the accumulator,
+ * the timestep, the timescale including the pause state, and the tick and simulation clocks. Wall-clock bookkeeping and
+ * statistics are deliberately excluded so a snapshot can be restored at any time, in any process.
+ * Can be copied with memcpy; use TmSerializeTimingState for a portable byte representation.
+ */
+typedef struct
+{
+    double accumulator;
+    double physicsTimeStep;
+    double timeScale;
+    double timeScaleBeforePause;
+    uint64_t physicsHz;
+    uint64_t tick;
+    int64_t simTimeNs;
+    uint64_t stepNumNs;
+    uint64_t stepDen;
+    int64_t unscaledTimeNs;
+} TmTimingState;
+
+/**
+ * @brief Callback receiving a batch of consecutive fixed steps.
+ *
+ * @param userData The pointer passed alongside the callback.
+ * @param firstTick Tick index of the first step in this batch.
+ * @param stepCount Number of fixed steps to simulate in this batch.
+ * @param fixedTimestep Duration of each step in seconds.
+ */
+typedef void (*TmStepBatchFn)(void* userData, uint64_t firstTick, size_t stepCount, double fixedTimestep);
+
+typedef struct
+{
+    /** Tick whose state lies at or before the time. */
+    uint64_t tick;
+    /** Fraction in [0, 1) of the way from tick to tick + 1. */
+    double fraction;
+} TmTickPosition;
+
+/**
+ * @brief Callback simulating a single fixed step.
+ *
+ * @param userData The pointer passed alongside the callback.
+ * @param tick Tick index the step runs on; the step advances the state from tick to tick + 1.
+ * @param fixedTimestep Duration of the step in seconds.
+ */
+typedef void (*TmStepFn)(void* userData, uint64_t tick, double fixedTimestep);
+
+typedef struct
+{
+    /** Saves the complete game state before speculation. Must not be null. */
+    void (*save)(void* userData);
+    /** Restores the game state saved by save. Must not be null. */
+    void (*restore)(void* userData);
+    /** Simulates one speculative step from the latest input. Must not be null. */
+    TmStepFn step;
+    /** Pointer passed through to every callback. */
+    void* userData;
+} TmRunAheadCallbacks;
+
+typedef struct
+{
+    /** Speculative steps run by the last TmBeginRunAhead. */
+    size_t steps;
+    /** Seconds spent in the save callback during the last run-ahead. */
+    double saveTime;
+    /** Seconds spent in speculative steps during the last run-ahead. */
+    double stepTime;
+    /** Seconds spent in the restore callback during the last run-ahead. */
+    double restoreTime;
+    /** Average total run-ahead cost per frame in seconds over the lifetime of the TimeManager. */
+    double averageTime;
+    /** Largest total run-ahead cost of a single frame in seconds. */
+    double maxTime;
+} TmRunAheadStats;
+
+typedef struct
+{
+    /** Steps re-simulated by the last correction. */
+    size_t steps;
+    /** Seconds the last correction took. */
+    double time;
+    /** Number of corrections over the lifetime of the TimeManager. */
+    size_t corrections;
+    /** Largest number of steps a single correction re-simulated. */
+    size_t maxSteps;
+    /** Longest a single correction took, in seconds. */
+    double maxTime;
+    /** Average seconds per correction. */
+    double averageTime;
+} TmResimulationStats;
+
+/**
+ * @brief Callback measuring how stiff the upcoming fixed step is.
+ *
+ * The returned metric is expressed in substeps needed, e.g. a CFL number such as
+ * maxVelocity * fixedTimestep / characteristicLength. It is rounded up and clamped to
+ * [1, maxSubsteps] to give the substep count.
+ *
+ * @param userData The pointer passed to TmSetSubstepMetric.
+ * @return The stiffness metric for the next fixed step.
+ */
+typedef double (*TmStiffnessFn)(void* userData);
+
+typedef struct
+{
+    /**
+     * Number of substeps the current fixed step is split into. Always at least 1.
+     */
+    size_t substeps;
+    /**
+     * Duration of each substep in seconds, fixedTimestep / substeps.
+     */
+    double substepDt;
+    /**
+     * Fraction of the fixed step covered by each substep, 1 / substeps. Substep i ends at
+     * (i + 1) * alphaStep of the way from the previous to the next fixed step state.
+     */
+    double alphaStep;
+} TmSubstepInfo;
+
+typedef struct
+{
+    /**
+     * Fixed steps split into substeps since the last TmBeginFrame.
+     */
+    size_t steps;
+    /**
+     * Total substeps those fixed steps were split into.
+     */
+    size_t substeps;
+    /**
+     * Largest substep count of a single fixed step since the last TmBeginFrame.
+     */
+    size_t maxSubsteps;
+    /**
+     * Average substeps per fixed step over the lifetime of the TimeManager.
+     */
+    double averageSubsteps;
+} TmSubstepStats;
+
+typedef struct
+{
+    /**
+     * Time in seconds the phase took in the last completed frame, 0 if it was not marked in it.
+     */
+    double last;
+    /**
+     * Average time per frame in seconds over the recent frames, counting frames without the phase as 0.
+     */
+    double average;
+    /**
+     * Longest time in a single frame in seconds over the same recent frames.
+     */
+    double max;
+    /**
+     * Budget set with TmSetPhaseBudget, 0 if none.
+     */
+    double budget;
+    /**
+     * Frames in which the phase exceeded its budget since creation or the last TmReset.
+     */
+    size_t overBudgetFrames;
+} TmPhaseStats;
+
+typedef struct
+{
+    /**
+     * Presents marked since creation or the last TmReset.
+     */
+    size_t presents;
+    /**
+     * Latest present-to-present interval in seconds.
+     */
+    double lastInterval;
+    /**
+     * Smoothed present-to-present interval in seconds.
+     */
+    double averageInterval;
+    /**
+     * Longest present-to-present interval in seconds.
+     */
+    double maxInterval;
+    /**
+     * Extra refreshes an image stayed on screen beyond the swap interval, i.e. repeated refreshes.
+     */
+    size_t repeatedRefreshes;
+    /**
+     * Presents closer than half a refresh to the previous one.
+     *
+     * With TmMarkPresent these are usually presents queued behind a late frame, which a FIFO swap
+     * chain still shows; only display timestamps passed to TmMarkPresentAt make them dropped frames.
+     */
+    size_t earlyPresents;
+} TmPresentStats;
+
+/**
+ * @brief Returns the interpolation factor at the end of a substep within its fixed step.
+ *
+ * @param info Substep info returned by TmComputeSubsteps.
+ * @param index Zero-based substep index.
+ * @return Fraction in (0, 1] of the way from the previous to the next fixed step state.
+ */
+static inline double TmSubstepAlpha(const TmSubstepInfo* info, const size_t index)
+{
+    return (double)(index + 1) * info->alphaStep;
+}
+
 
 /**
  * @brief Creates and initializes a new TimeManager instance.
@@ -168,6 +516,66 @@ TIME_MANAGER_API void TmDestroy(TimeManager* tm);
  */
 TIME_MANAGER_API FrameTimingData TmBeginFrame(TimeManager* tm);
 
+/**
+ * @brief Advances the simulation by an exact number of fixed steps without reading the clock.
+ *
+ * Headless counterpart to TmBeginFrame for offline and batch runs. No time source is queried,
+ * FPS statistics are left untouched and neither maxFrameTime nor maxPhysicsSteps is applied.
+ * The accumulator remainder is preserved, so headless and real-time frames can be mixed and
+ * still produce the same step count for the same amount of simulated time.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param steps Number of fixed steps to run.
+ * @return FrameTimingData with physicsSteps set to steps and frameTime set to the simulated time.
+ *         rawFrameTime and unscaledFrameTime are zero since no wall-clock time elapsed.
+ */
+TIME_MANAGER_API FrameTimingData TmAdvanceSteps(TimeManager* tm, size_t steps);
+
+/**
+ * @brief Advances the simulation by a given amount of simulated time without reading the clock.
+ *
+ * The time is added to the accumulator as-is: it is already simulation time, so the timescale
+ * and pause state are not applied, and no frame time or step count clamping takes place.
+ * Steps are computed with exactly the same accumulator math as TmBeginFrame.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param simTime Simulated time to advance in seconds. Must not be negative.
+ * @return FrameTimingData for the advance. lagging is always false, rawFrameTime and
+ *         unscaledFrameTime are zero since no wall-clock time elapsed.
+ */
+TIME_MANAGER_API FrameTimingData TmAdvanceSimTime(TimeManager* tm, double simTime);
+
+/**
+ * @brief Computes how many fixed steps an elapsed wall-clock interval would produce.
+ *
+ * The interval is scaled by the current timescale and added to the current accumulator in
+ * constant time, without applying maxFrameTime or maxPhysicsSteps. The TimeManager is not
+ * modified.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param elapsed Elapsed wall-clock time in seconds.
+ * @return The number of whole fixed steps covering the interval.
+ */
+TIME_MANAGER_API size_t TmComputeCatchUpSteps(const TimeManager* tm, double elapsed);
+
+/**
+ * @brief Simulates an arbitrarily long wall-clock interval at full throughput.
+ *
+ * Intended for catching up after a debugger break, suspend or long stall: the step count is
+ * computed in constant time as with TmComputeCatchUpSteps and handed to stepFn in batches of at
+ * most chunkSize steps, instead of being trickled out maxPhysicsSteps per frame. The accumulator
+ * keeps the remainder. Typical use is passing FrameTimingData::droppedTime after a long frame.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param elapsed Elapsed wall-clock time in seconds to simulate.
+ * @param chunkSize Maximum number of steps per callback. Zero uses DEFAULT_FAST_FORWARD_CHUNK.
+ * @param stepFn Callback that simulates a batch of steps. Must not be null.
+ * @param userData Pointer passed through to stepFn.
+ * @return The total number of steps handed to stepFn.
+ */
+TIME_MANAGER_API size_t TmFastForward(TimeManager* tm, double elapsed, size_t chunkSize, TmStepBatchFn stepFn,
+                                      void* userData);
+
 /**
  * @brief Sets the physics update frequency and calculates the corresponding time step.
  *
@@ -327,6 +735,7 @@ TIME_MANAGER_API size_t TmGetPhysicsHz(const TimeManager* tm);
  *
  * This function provides the average FPS calculated over time, as stored within the TimeManager.
  * The average FPS serves as a performance metric, reflecting the rendering efficiency of the application.
+ * Always 0 when built with TM_STATS_NONE.
  *
  * @param tm Pointer to the TimeManager structure containing the average FPS value.
  * @return The average frames per second as a double.
@@ -349,8 +758,9 @@ TIME_MANAGER_API size_t TmGetPhysicsSteps(const TimeManager* tm);
  * @brief Resets the state of the TimeManager instance to its initial values.
  *
  * This function initializes or resets various fields in the provided TimeManager structure,
- * such as resetting frame counters, accumulators, time tracking, and statistics for physics updates
- * and frame rate calculations. Ensures a clean and consistent start for the time management system.
+ * such as resetting frame counters, accumulators, time tracking, and statistics for physics updates,
+ * frame rate, phase and present calculations. Phase budgets and the refresh period are kept.
+ * Ensures a clean and consistent start for the time management system.
  *
  * @param tm A pointer to the TimeManager structure to be reset.
  */
@@ -390,6 +800,383 @@ TIME_MANAGER_API void TmResume(TimeManager* tm);
  */
 TIME_MANAGER_API bool TmIsPaused(const TimeManager* tm);
 
+/**
+ * @brief Reads the TimeManager's time source.
+ *
+ * Returns the current time from the clock set with TmSetTimeSource, so timestamps taken
+ * elsewhere in the frame are on the same timeline as TmBeginFrame.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return The current time of the TimeManager's clock.
+ */
+TIME_MANAGER_API HighResTimeT TmNow(const TimeManager* tm);
+
+/**
+ * @brief Retrieves the time the current frame started.
+ *
+ * This is the clock sample the latest TmBeginFrame measured the frame with, on the same timeline
+ * as TmNow, so TmNow(tm) minus this is the time spent in the frame so far.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Start time of the current frame.
+ */
+TIME_MANAGER_API HighResTimeT TmGetFrameStartTime(const TimeManager* tm);
+
+/**
+ * @brief Recomputes render timing for a later timestamp without modifying the TimeManager.
+ *
+ * interpolationAlpha from TmBeginFrame is stale by the time a frame is presented. This projects
+ * the current accumulator forward to the given timestamp (typically the expected present time)
+ * with the current timescale and maxFrameTime, and returns the alpha and simulation time for it.
+ * Timestamps before the start of the frame are treated as the frame start.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param timestamp The time to latch for, on the TimeManager's clock (see TmNow).
+ * @return Render timing at the timestamp.
+ */
+TIME_MANAGER_API TmLatchedTiming TmLatchTiming(const TimeManager* tm, HighResTimeT timestamp);
+
+/**
+ * @brief Maps a timestamp to the fixed step it happened in.
+ *
+ * TmBeginFrame runs a frame's steps in one burst, but each step covers its own slice of wall-clock
+ * time. This uses the wall-clock and simulation times recorded at recent frames, together with the
+ * timescale and maxFrameTime, to find the step whose slice contains the timestamp, e.g. so input from
+ * another thread can be applied on the step it actually happened in instead of the frame's first.
+ * Timestamps after the latest frame are projected at the current timescale, as in TmLatchTiming;
+ * timestamps older than the recorded frames map to the oldest recorded frame. Steps issued by
+ * TmFastForward, TmAdvanceSteps or TmAdvanceSimTime count as run at the latest frame's time, and
+ * TmRestoreTimingState forgets the frames before the restore.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param timestamp The time to map, on the TimeManager's clock (see TmNow).
+ * @return The tick of the step containing the timestamp and the fraction into that step.
+ */
+TIME_MANAGER_API TmTickPosition TmMapTimestampToTick(const TimeManager* tm, HighResTimeT timestamp);
+
+/**
+ * @brief Captures the timing state of a TimeManager.
+ *
+ * Only copies a handful of fields, cheap enough to call for every rollback frame.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param state Destination snapshot. Must not be null.
+ */
+TIME_MANAGER_API void TmSaveTimingState(const TimeManager* tm, TmTimingState* state);
+
+/**
+ * @brief Restores a timing state previously captured with TmSaveTimingState.
+ *
+ * The clock itself is not rewound: the next TmBeginFrame still measures the wall time since the
+ * previous frame and adds it on top of the restored accumulator.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param state Snapshot to restore. Must not be null.
+ */
+TIME_MANAGER_API void TmRestoreTimingState(TimeManager* tm, const TmTimingState* state);
+
+/**
+ * @brief Serializes a timing state into a portable little-endian byte representation.
+ *
+ * The format is versioned and independent of the host's endianness, padding and size_t width,
+ * so it can be sent to another process or machine.
+ *
+ * @param state Snapshot to serialize. Must not be null.
+ * @param buffer Destination buffer.
+ * @param bufferSize Size of buffer in bytes, at least TM_TIMING_STATE_SERIALIZED_SIZE.
+ * @return Number of bytes written, or 0 if the buffer is too small.
+ */
+TIME_MANAGER_API size_t TmSerializeTimingState(const TmTimingState* state, void* buffer, size_t bufferSize);
+
+/**
+ * @brief Deserializes a timing state written by TmSerializeTimingState.
+ *
+ * @param state Destination snapshot. Must not be null. Left untouched on failure.
+ * @param buffer Serialized bytes.
+ * @param bufferSize Number of bytes available in buffer.
+ * @return True on success, false if the data is truncated, of an unknown version or invalid.
+ */
+TIME_MANAGER_API bool TmDeserializeTimingState(TmTimingState* state, const void* buffer, size_t bufferSize);
+
+/**
+ * @brief Selects whether render timing interpolates or extrapolates.
+ *
+ * Interpolation renders one step behind, between the previous and latest physics state.
+ * Extrapolation (dead reckoning) renders at the current time, past the latest state, which cuts
+ * perceived latency at the cost of occasional mispredictions.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param mode The render mode used by TmBeginFrame and the headless advance functions.
+ */
+TIME_MANAGER_API void TmSetRenderMode(TimeManager* tm, TmRenderMode mode);
+
+/**
+ * @brief Retrieves the current render mode.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return The active TmRenderMode.
+ */
+TIME_MANAGER_API TmRenderMode TmGetRenderMode(const TimeManager* tm);
+
+/**
+ * @brief Caps interpolationAlpha in TM_RENDER_EXTRAPOLATE mode.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param maxAlpha Largest alpha reported, values below 1.0 are raised to 1.0.
+ *                 The default DEFAULT_MAX_EXTRAPOLATION_ALPHA allows one full step past the latest state.
+ */
+TIME_MANAGER_API void TmSetMaxExtrapolationAlpha(TimeManager* tm, double maxAlpha);
+
+/**
+ * @brief Retrieves the extrapolation alpha cap.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return The largest alpha reported in TM_RENDER_EXTRAPOLATE mode.
+ */
+TIME_MANAGER_API double TmGetMaxExtrapolationAlpha(const TimeManager* tm);
+
+/**
+ * @brief Splits every fixed step into a constant number of substeps.
+ *
+ * Clears any stiffness metric set with TmSetSubstepMetric.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param divisor Substeps per fixed step. Zero is treated as 1 (no substepping).
+ */
+TIME_MANAGER_API void TmSetSubstepDivisor(TimeManager* tm, size_t divisor);
+
+/**
+ * @brief Chooses the substep count of every fixed step from a caller-supplied stiffness metric.
+ *
+ * The metric is evaluated once per fixed step by TmComputeSubsteps, so steps only pay for
+ * substeps while the simulation is actually stiff.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param metricFn Stiffness callback, or null to fall back to the fixed divisor.
+ * @param userData Pointer passed through to metricFn.
+ * @param maxSubsteps Upper bound on substeps per fixed step. Zero uses DEFAULT_MAX_SUBSTEPS.
+ */
+TIME_MANAGER_API void TmSetSubstepMetric(TimeManager* tm, TmStiffnessFn metricFn, void* userData,
+                                         size_t maxSubsteps);
+
+/**
+ * @brief Computes the substeps for the next fixed step.
+ *
+ * Call once per fixed step, before simulating it. Uses the stiffness metric when one is set,
+ * the fixed divisor otherwise, and records the result in the substep statistics. Performs no
+ * allocation; the configuration is reused across frames.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Substep count, substep duration and interpolation data for the step.
+ */
+TIME_MANAGER_API TmSubstepInfo TmComputeSubsteps(TimeManager* tm);
+
+/**
+ * @brief Retrieves the substepping cost statistics.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Substep counts since the last TmBeginFrame and the lifetime average.
+ */
+TIME_MANAGER_API TmSubstepStats TmGetSubstepStats(const TimeManager* tm);
+
+/**
+ * @brief Marks the start of a frame phase.
+ *
+ * Phases are timed with the TimeManager's clock and summed per frame, so a phase may be entered
+ * several times in one frame. A phase still open at TmBeginFrame is split at the frame boundary.
+ * Costs one clock read and performs no allocation.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param phase The phase being entered.
+ */
+TIME_MANAGER_API void TmPhaseBegin(TimeManager* tm, TmFramePhase phase);
+
+/**
+ * @brief Marks the end of a frame phase started with TmPhaseBegin.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param phase The phase being left. Ignored if it was not begun.
+ */
+TIME_MANAGER_API void TmPhaseEnd(TimeManager* tm, TmFramePhase phase);
+
+/**
+ * @brief Sets the per-frame time budget of a phase.
+ *
+ * Frames in which the phase takes longer set its bit in FrameTimingData.phaseBudgetExceeded.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param phase The phase to budget.
+ * @param budget Budget in seconds per frame. 0 disables the check.
+ */
+TIME_MANAGER_API void TmSetPhaseBudget(TimeManager* tm, TmFramePhase phase, double budget);
+
+/**
+ * @brief Retrieves the rolling timing statistics of a phase.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param phase The phase to query.
+ * @return Time of the last completed frame, average and max over recent frames, and budget overruns.
+ */
+TIME_MANAGER_API TmPhaseStats TmGetPhaseStats(const TimeManager* tm, TmFramePhase phase);
+
+/**
+ * @brief Records that a frame was presented now.
+ *
+ * Call right after the present call returns. The present-to-present interval is reported in
+ * FrameTimingData.presentInterval by the next TmBeginFrame and in TmGetPresentStats.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ */
+TIME_MANAGER_API void TmMarkPresent(TimeManager* tm);
+
+/**
+ * @brief Records a present with an explicit timestamp, e.g. the display time reported by the swap chain.
+ *
+ * Timestamps at or before the previous present are ignored.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param timestamp Time of the present on the TimeManager's clock (see TmNow).
+ */
+TIME_MANAGER_API void TmMarkPresentAt(TimeManager* tm, HighResTimeT timestamp);
+
+/**
+ * @brief Sets the display refresh period used to detect repeated refreshes and early presents.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param refreshPeriod Seconds per display refresh, e.g. 1.0 / 60.0. 0 disables refresh analysis.
+ * @param swapInterval Refreshes each frame is meant to stay on screen, usually 1. 0 is treated as 1.
+ */
+TIME_MANAGER_API void TmSetRefreshPeriod(TimeManager* tm, double refreshPeriod, size_t swapInterval);
+
+/**
+ * @brief Retrieves present-to-present statistics.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Interval and refresh statistics of the marked presents.
+ */
+TIME_MANAGER_API TmPresentStats TmGetPresentStats(const TimeManager* tm);
+
+/**
+ * @brief Configures run-ahead, emulator-style input latency reduction.
+ *
+ * Each frame TmBeginRunAhead saves the game state, simulates the given number of speculative
+ * steps from the latest input so they can be rendered, and TmEndRunAhead rolls them back. The
+ * TimeManager's accumulator and tick are never touched by speculation.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param steps Speculative steps per frame, zero disables run-ahead.
+ * @param callbacks Save, restore and step callbacks. Copied; may be null when steps is zero.
+ */
+TIME_MANAGER_API void TmSetRunAhead(TimeManager* tm, size_t steps, const TmRunAheadCallbacks* callbacks);
+
+/**
+ * @brief Saves the game state and runs the speculative steps for this frame.
+ *
+ * Call after the frame's real fixed steps, then render the speculative state and call
+ * TmEndRunAhead. The steps run on ticks TmGetTick(tm) onwards, the ones the real simulation
+ * will run next.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Number of speculative steps run, zero when run-ahead is disabled.
+ */
+TIME_MANAGER_API size_t TmBeginRunAhead(TimeManager* tm);
+
+/**
+ * @brief Rolls back the speculative steps of TmBeginRunAhead by restoring the saved state.
+ *
+ * Does nothing if no run-ahead is in progress.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ */
+TIME_MANAGER_API void TmEndRunAhead(TimeManager* tm);
+
+/**
+ * @brief Retrieves what run-ahead speculation costs.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Timings of the last run-ahead and lifetime averages, measured with GetHighResolutionTime so
+ *         a scripted time source is not consumed.
+ */
+TIME_MANAGER_API TmRunAheadStats TmGetRunAheadStats(const TimeManager* tm);
+
+/**
+ * @brief Re-simulates from a server-acknowledged tick up to the present tick.
+ *
+ * Client-side prediction driver: after the caller has restored the authoritative state for
+ * ackedTick and re-applied its pending inputs, this replays steps ackedTick .. TmGetTick(tm) - 1
+ * in one tight loop at the manager's current timestep, bringing the state back to the present
+ * tick. The TimeManager's own tick and accumulator are not modified.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param ackedTick Tick of the authoritative state the re-simulation starts from.
+ * @param stepFn Callback simulating one step. Must not be null.
+ * @param userData Pointer passed through to stepFn.
+ * @return Number of steps re-simulated, zero if ackedTick is not in the past; such calls leave the
+ *         resimulation statistics untouched.
+ */
+TIME_MANAGER_API size_t TmResimulate(TimeManager* tm, uint64_t ackedTick, TmStepFn stepFn, void* userData);
+
+/**
+ * @brief Retrieves the re-simulation cost per correction.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Step counts and timings of corrections, measured with GetHighResolutionTime so a scripted
+ *         time source is not consumed.
+ */
+TIME_MANAGER_API TmResimulationStats TmGetResimulationStats(const TimeManager* tm);
+
+/**
+ * @brief Retrieves the tick counter.
+ *
+ * The number of fixed steps issued over the lifetime of the TimeManager by TmBeginFrame, the
+ * headless advance functions and TmFastForward. This is the tick the next step will run on.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return The current tick.
+ */
+TIME_MANAGER_API uint64_t TmGetTick(const TimeManager* tm);
+
+/**
+ * @brief Retrieves the simulation time of the current tick in nanoseconds.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Exact simulation time at TmGetTick, excluding the accumulator remainder.
+ */
+TIME_MANAGER_API int64_t TmGetSimTimeNs(const TimeManager* tm);
+
+/**
+ * @brief Converts a tick index to simulation time in nanoseconds.
+ *
+ * Exact across timestep changes for ticks at or after the most recent change. Earlier ticks are
+ * extrapolated with the current timestep.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param tick The tick index to convert.
+ * @return Simulation time of the tick in nanoseconds.
+ */
+TIME_MANAGER_API int64_t TmGetSimTimeAtTick(const TimeManager* tm, uint64_t tick);
+
+/**
+ * @brief Converts simulation time to the tick it falls into.
+ *
+ * The inverse of TmGetSimTimeAtTick, consistent with it at exact tick boundaries. Times before
+ * tick 0 map to tick 0 with a zero fraction.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param simTimeNs Simulation time in nanoseconds.
+ * @return The tick at or before the time and the fraction towards the next tick.
+ */
+TIME_MANAGER_API TmTickPosition TmGetTickAtSimTime(const TimeManager* tm, int64_t simTimeNs);
+
+/**
+ * @brief Retrieves the total unscaled wall-clock time fed into the simulation.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @return Sum of the capped, unscaled frame times in nanoseconds, less the time dropped by the
+ *         maxPhysicsSteps clamp, plus the time passed to TmFastForward.
+ */
+TIME_MANAGER_API int64_t TmGetUnscaledTimeNs(const TimeManager* tm);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,153 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_TRACE_EXPORTER_H
+#define TIME_MANAGER_TRACE_EXPORTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "time_manager/time_manager.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+static const size_t DEFAULT_TRACE_CAPACITY = 8192;       // events
+static const unsigned DEFAULT_TRACE_FLUSH_INTERVAL = 50; // milliseconds
+
+/**
+ * @brief Streams the frame timeline to a Chrome trace-event JSON file.
+ *
+ * Events go into a preallocated single-producer ring and a background thread formats and writes
+ * them, so recording costs a few stores on the frame thread and never blocks on I/O. When the
+ * writer falls behind, new events are dropped and counted. The file uses the JSON array format,
+ * which chrome://tracing and the Perfetto UI open even if the process dies before the closing
+ * bracket is written.
+ *
+ * Attached to a TimeManager it records a span per frame (physics steps, tick, lagging and time
+ * scale as arguments), a span per TmPhaseBegin/TmPhaseEnd pair and counter tracks for the
+ * lagging flag and the time scale. Physics step spans can be added with TmTraceExporterRecordStep.
+ * All recording functions must be called from one thread.
+ */
+typedef struct TmTraceExporter TmTraceExporter;
+
+typedef struct
+{
+    /** File to create or overwrite. Must not be null. */
+    const char* path;
+    /** Ring size in events, rounded up to a power of two. Must be > 0. */
+    size_t capacity;
+    /** How long the writer sleeps after draining the ring, in milliseconds. */
+    unsigned flushInterval;
+} TmTraceExporterConfig;
+
+typedef struct
+{
+    /** Events handed to the exporter. */
+    size_t recorded;
+    /** Events dropped because the ring was full. */
+    size_t dropped;
+    /** Events written to the file so far. */
+    size_t written;
+} TmTraceStats;
+
+static inline TmTraceExporterConfig TmTraceExporterDefaultConfig(const char* path)
+{
+    return (TmTraceExporterConfig){
+        .path = path,
+        .capacity = DEFAULT_TRACE_CAPACITY,
+        .flushInterval = DEFAULT_TRACE_FLUSH_INTERVAL
+    };
+}
+
+/**
+ * @brief Opens the trace file and starts the writer thread.
+ *
+ * @param config Exporter configuration. Must not be null.
+ * @return The new exporter, or null if the configuration is invalid, the file cannot be created
+ *         or the thread cannot be started.
+ */
+TIME_MANAGER_API TmTraceExporter* TmTraceExporterCreate(const TmTraceExporterConfig* config);
+
+/**
+ * @brief Writes the remaining events, closes the file and stops the writer thread.
+ *
+ * Detach the exporter from any TimeManager first.
+ *
+ * @param exporter The exporter to free. Null is ignored.
+ */
+TIME_MANAGER_API void TmTraceExporterDestroy(TmTraceExporter* exporter);
+
+/**
+ * @brief Attaches a trace exporter so frames, phases and time scale changes are recorded.
+ *
+ * Events are only fed to it when the library is built with TM_STATS_TRACING.
+ *
+ * @param tm Pointer to the TimeManager instance. Must not be null.
+ * @param exporter The exporter to attach, or null to detach.
+ */
+TIME_MANAGER_API void TmAttachTraceExporter(TimeManager* tm, TmTraceExporter* exporter);
+
+/**
+ * @brief Records a frame span. Called by TmBeginFrame when attached.
+ *
+ * Also updates the lagging and time scale counters when they change.
+ *
+ * @param exporter Pointer to the exporter. Must not be null.
+ * @param beginNs Start of the frame (the previous TmBeginFrame).
+ * @param endNs End of the frame.
+ * @param frame The TmBeginFrame result that closed the frame. Must not be null.
+ */
+TIME_MANAGER_API void TmTraceExporterRecordFrame(TmTraceExporter* exporter, int64_t beginNs, int64_t endNs,
+                                                 const FrameTimingData* frame);
+
+/**
+ * @brief Records a phase span. Called by TmPhaseEnd when attached.
+ *
+ * @param exporter Pointer to the exporter. Must not be null.
+ * @param phase The phase.
+ * @param beginNs Start of the phase.
+ * @param endNs End of the phase.
+ */
+TIME_MANAGER_API void TmTraceExporterRecordPhase(TmTraceExporter* exporter, TmFramePhase phase, int64_t beginNs,
+                                                 int64_t endNs);
+
+/**
+ * @brief Records a single physics step.
+ *
+ * @param exporter Pointer to the exporter. Must not be null.
+ * @param tick Tick the step advanced from.
+ * @param beginNs Start of the step.
+ * @param endNs End of the step.
+ */
+TIME_MANAGER_API void TmTraceExporterRecordStep(TmTraceExporter* exporter, uint64_t tick, int64_t beginNs,
+                                                int64_t endNs);
+
+/**
+ * @brief Records a time scale change, if it differs from the last one recorded.
+ *
+ * Called by TmSetTimeScale, TmPause and TmResume when attached.
+ *
+ * @param exporter Pointer to the exporter. Must not be null.
+ * @param timeNs When the change happened.
+ * @param timeScale The new time scale.
+ */
+TIME_MANAGER_API void TmTraceExporterRecordTimeScale(TmTraceExporter* exporter, int64_t timeNs, double timeScale);
+
+/**
+ * @brief Retrieves event counters.
+ *
+ * @param exporter Pointer to the exporter. Must not be null.
+ * @return Recorded, dropped and written event counts.
+ */
+TIME_MANAGER_API TmTraceStats TmTraceExporterGetStats(const TmTraceExporter* exporter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_TRACE_EXPORTER_H
@@ -0,0 +1,38 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_EXTRAPOLATE_H
+#define TIME_MANAGER_EXTRAPOLATE_H
+
+#include <stddef.h>
+
+#include "time_manager/time_manager_export.h"
+
+// @formatter:off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// @formatter:on
+
+/**
+ * @brief Dead-reckons a batch of positions forward in time.
+ *
+ * Computes out[i] = positions[i] + velocities[i] * time for every component, using SSE on x86
+ * and NEON on ARM when available. The arrays are flat component arrays (e.g. x0, y0, z0, x1, ...)
+ * and need no particular alignment. out may be the same array as positions.
+ *
+ * @param out Destination array of count floats.
+ * @param positions Latest simulated positions, count floats.
+ * @param velocities Latest simulated velocities, count floats.
+ * @param count Number of components in each array.
+ * @param time Time to extrapolate by in seconds, typically FrameTimingData::extrapolationTime.
+ */
+TIME_MANAGER_API void TmExtrapolatePositions(float* out, const float* positions, const float* velocities, size_t count,
+                                             float time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIME_MANAGER_EXTRAPOLATE_H
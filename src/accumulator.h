@@ -0,0 +1,34 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_ACCUMULATOR_H
+#define TIME_MANAGER_ACCUMULATOR_H
+
+#include <math.h>
+#include <stdbool.h>
+
+// Accumulator arithmetic shared by the fixed-step loop and the rate limiter. Amounts built from
+// repeated additions land a rounding error short of whole numbers, so anything within
+// FLOATING_POINT_EPSILON below a whole unit counts as having reached it.
+
+static const double FLOATING_POINT_EPSILON = 1e-12;
+
+// Whole units of the given size in an accumulated amount
+static inline double WholeUnits(const double amount, const double unit)
+{
+    return floor((amount + FLOATING_POINT_EPSILON) / unit);
+}
+
+// Takes cost out of the amount if it is there, clamping the rounding shortfall at zero
+static inline bool ConsumeUnits(double* amount, const double cost)
+{
+    if (*amount + FLOATING_POINT_EPSILON < cost)
+    {
+        return false;
+    }
+    *amount = *amount > cost ? *amount - cost : 0.0;
+    return true;
+}
+
+#endif //TIME_MANAGER_ACCUMULATOR_H
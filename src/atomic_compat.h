@@ -0,0 +1,72 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_ATOMIC_COMPAT_H
+#define TIME_MANAGER_ATOMIC_COMPAT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Minimal size_t atomics for the lock-free queues. MSVC's C mode has no usable <stdatomic.h>,
+// so it uses the Interlocked functions (full barriers); gcc and clang use the __atomic builtins.
+
+#ifdef _MSC_VER
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+typedef volatile size_t TmAtomicSize;
+
+static inline size_t TmAtomicLoadAcquire(TmAtomicSize* p)
+{
+    return (size_t)InterlockedCompareExchangePointer((PVOID volatile*)p, NULL, NULL);
+}
+
+static inline size_t TmAtomicLoadRelaxed(TmAtomicSize* p)
+{
+    return *p;
+}
+
+static inline void TmAtomicStoreRelease(TmAtomicSize* p, const size_t value)
+{
+    (void)InterlockedExchangePointer((PVOID volatile*)p, (PVOID)value);
+}
+
+static inline bool TmAtomicCompareExchange(TmAtomicSize* p, size_t* expected, const size_t desired)
+{
+    const size_t previous =
+        (size_t)InterlockedCompareExchangePointer((PVOID volatile*)p, (PVOID)desired, (PVOID)*expected);
+    if (previous == *expected)
+    {
+        return true;
+    }
+    *expected = previous;
+    return false;
+}
+#else
+typedef size_t TmAtomicSize;
+
+static inline size_t TmAtomicLoadAcquire(TmAtomicSize* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline size_t TmAtomicLoadRelaxed(TmAtomicSize* p)
+{
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+static inline void TmAtomicStoreRelease(TmAtomicSize* p, const size_t value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+static inline bool TmAtomicCompareExchange(TmAtomicSize* p, size_t* expected, const size_t desired)
+{
+    return __atomic_compare_exchange_n(p, expected, desired, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+#endif
+
+#endif //TIME_MANAGER_ATOMIC_COMPAT_H
@@ -0,0 +1,79 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_BYTE_ORDER_H
+#define TIME_MANAGER_BYTE_ORDER_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Little-endian encoding helpers for the portable binary formats. Doubles are written as
+// their IEEE-754 bit pattern, which every supported platform uses.
+
+static inline unsigned char* PutU16(unsigned char* p, const uint16_t v)
+{
+    p[0] = (unsigned char)(v & 0xFFu);
+    p[1] = (unsigned char)(v >> 8);
+    return p + 2;
+}
+
+static inline unsigned char* PutU32(unsigned char* p, const uint32_t v)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        p[i] = (unsigned char)((v >> (8 * i)) & 0xFFu);
+    }
+    return p + 4;
+}
+
+static inline unsigned char* PutU64(unsigned char* p, const uint64_t v)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        p[i] = (unsigned char)((v >> (8 * i)) & 0xFFu);
+    }
+    return p + 8;
+}
+
+static inline unsigned char* PutF64(unsigned char* p, const double v)
+{
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof bits);
+    return PutU64(p, bits);
+}
+
+static inline uint16_t GetU16(const unsigned char* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t GetU32(const unsigned char* p)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        v |= (uint32_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+static inline uint64_t GetU64(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        v |= (uint64_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+static inline double GetF64(const unsigned char* p)
+{
+    const uint64_t bits = GetU64(p);
+    double v;
+    memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
+#endif //TIME_MANAGER_BYTE_ORDER_H
@@ -0,0 +1,55 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/utils/extrapolate.h"
+
+#include <assert.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define TM_EXTRAPOLATE_SSE 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define TM_EXTRAPOLATE_NEON 1
+#endif
+
+void TmExtrapolatePositions(float* out, const float* positions, const float* velocities, const size_t count,
+                            const float time)
+{
+    assert((count == 0 || (out != NULL && positions != NULL && velocities != NULL)) && "array pointer is null!");
+
+    size_t i = 0;
+
+    #if defined(TM_EXTRAPOLATE_SSE)
+    const __m128 t = _mm_set1_ps(time);
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128 p0 = _mm_loadu_ps(positions + i);
+        const __m128 p1 = _mm_loadu_ps(positions + i + 4);
+        const __m128 v0 = _mm_loadu_ps(velocities + i);
+        const __m128 v1 = _mm_loadu_ps(velocities + i + 4);
+        _mm_storeu_ps(out + i, _mm_add_ps(p0, _mm_mul_ps(v0, t)));
+        _mm_storeu_ps(out + i + 4, _mm_add_ps(p1, _mm_mul_ps(v1, t)));
+    }
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 p = _mm_loadu_ps(positions + i);
+        const __m128 v = _mm_loadu_ps(velocities + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(p, _mm_mul_ps(v, t)));
+    }
+    #elif defined(TM_EXTRAPOLATE_NEON)
+    const float32x4_t t = vdupq_n_f32(time);
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t p = vld1q_f32(positions + i);
+        const float32x4_t v = vld1q_f32(velocities + i);
+        vst1q_f32(out + i, vmlaq_f32(p, v, t));
+    }
+    #endif
+
+    for (; i < count; ++i)
+    {
+        out[i] = positions[i] + velocities[i] * time;
+    }
+}
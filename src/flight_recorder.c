@@ -0,0 +1,371 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/flight_recorder.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "byte_order.h"
+
+static const uint32_t FLIGHT_RECORDER_MAGIC = 0x52464D54u; // "TMFR"
+static const uint16_t FLIGHT_RECORDER_VERSION = 3;
+// Weight of a normal frame in the baseline frame time
+static const double BASELINE_SMOOTHING = 0.05;
+// Spike intervals within this fraction (or one frame) of each other count as periodic
+static const double PERIODIC_TOLERANCE = 0.2;
+// Spikes further apart than this are unrelated
+static const uint64_t PERIODIC_MAX_INTERVAL = 600;
+// Records staged per fwrite when dumping to a file
+#define DUMP_CHUNK_RECORDS 16
+
+struct TmFlightRecorder
+{
+    TmFlightRecorderConfig config;
+    TmFlightRecord* records;
+    size_t next;
+    size_t count;
+    uint64_t frames;
+
+    // Detector
+    double baseline;
+    bool hasBaseline;
+    uint64_t spikeFrames[3];
+    size_t spikeCount;
+    size_t lagRun;
+    TmHitchStats stats;
+
+    // Trigger
+    bool triggered;
+    bool frozen;
+    size_t postFramesLeft;
+    TmHitchKind triggerKind;
+    uint64_t triggerFrame;
+};
+
+TmFlightRecorder* TmFlightRecorderCreate(const TmFlightRecorderConfig* config)
+{
+    assert(config != NULL && "config pointer is null!");
+    if (config->capacity == 0 || !(config->spikeFactor > 1.0) || !(config->minSpike >= 0.0)
+        || config->sustainedLagFrames == 0 || config->capacity > SIZE_MAX / sizeof(TmFlightRecord))
+    {
+        return NULL;
+    }
+
+    TmFlightRecorder* recorder = calloc(1, sizeof *recorder);
+    if (!recorder)
+    {
+        return NULL;
+    }
+    recorder->records = malloc(config->capacity * sizeof *recorder->records);
+    if (!recorder->records)
+    {
+        free(recorder);
+        return NULL;
+    }
+    recorder->config = *config;
+    return recorder;
+}
+
+void TmFlightRecorderDestroy(TmFlightRecorder* recorder)
+{
+    if (recorder == NULL)
+    {
+        return;
+    }
+    free(recorder->records);
+    free(recorder);
+}
+
+// Spike with two earlier spikes at a regular interval
+static bool IsPeriodic(const TmFlightRecorder* recorder)
+{
+    if (recorder->spikeCount < 3)
+    {
+        return false;
+    }
+    const uint64_t first = recorder->spikeFrames[1] - recorder->spikeFrames[0];
+    const uint64_t second = recorder->spikeFrames[2] - recorder->spikeFrames[1];
+    if (first > PERIODIC_MAX_INTERVAL || second > PERIODIC_MAX_INTERVAL)
+    {
+        return false;
+    }
+    const double tolerance = fmax(1.0, PERIODIC_TOLERANCE * (double)first);
+    return fabs((double)second - (double)first) <= tolerance;
+}
+
+static TmHitchKind Classify(TmFlightRecorder* recorder, const FrameTimingData* frame, const uint64_t frameIndex)
+{
+    // Sustained lag is reported once per lagging run
+    recorder->lagRun = frame->lagging ? recorder->lagRun + 1 : 0;
+    if (recorder->lagRun == recorder->config.sustainedLagFrames)
+    {
+        recorder->stats.sustainedLags++;
+        return TM_HITCH_SUSTAINED_LAG;
+    }
+
+    const double raw = frame->rawFrameTime;
+    if (!(raw > 0.0))
+    {
+        return TM_HITCH_NONE;
+    }
+    if (!recorder->hasBaseline)
+    {
+        recorder->baseline = raw;
+        recorder->hasBaseline = true;
+        return TM_HITCH_NONE;
+    }
+
+    const bool spike =
+        raw > recorder->baseline * recorder->config.spikeFactor && raw - recorder->baseline > recorder->config.minSpike;
+    if (!spike)
+    {
+        recorder->baseline += (raw - recorder->baseline) * BASELINE_SMOOTHING;
+        return TM_HITCH_NONE;
+    }
+
+    if (recorder->spikeCount == 3)
+    {
+        recorder->spikeFrames[0] = recorder->spikeFrames[1];
+        recorder->spikeFrames[1] = recorder->spikeFrames[2];
+        recorder->spikeCount = 2;
+    }
+    recorder->spikeFrames[recorder->spikeCount++] = frameIndex;
+
+    if (IsPeriodic(recorder))
+    {
+        recorder->stats.periodicHitches++;
+        return TM_HITCH_PERIODIC;
+    }
+    recorder->stats.singleHitches++;
+    return TM_HITCH_SINGLE;
+}
+
+static void Freeze(TmFlightRecorder* recorder)
+{
+    recorder->frozen = true;
+    if (recorder->config.onTrigger)
+    {
+        recorder->config.onTrigger(recorder->config.userData, recorder, recorder->triggerKind);
+    }
+}
+
+TmHitchKind TmFlightRecorderRecord(TmFlightRecorder* recorder, const TimeManager* tm, const FrameTimingData* frame)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(frame != NULL && "frame pointer is null!");
+
+    const uint64_t frameIndex = recorder->frames++;
+    const TmHitchKind hitch = Classify(recorder, frame, frameIndex);
+    if (recorder->frozen)
+    {
+        return hitch;
+    }
+
+    TmFlightRecord* record = &recorder->records[recorder->next];
+    *record = (TmFlightRecord){
+        .frameIndex = frameIndex,
+        .startNs = TmGetFrameStartTime(tm).nanoseconds,
+        .tick = frame->tick,
+        .rawFrameTime = frame->rawFrameTime,
+        .frameTime = frame->frameTime,
+        .droppedTime = frame->droppedTime,
+        .presentInterval = frame->presentInterval,
+        .physicsSteps = (uint32_t)frame->physicsSteps,
+        .lagging = frame->lagging,
+        .phaseBudgetExceeded = frame->phaseBudgetExceeded,
+        .hitch = hitch
+    };
+    for (int phase = 0; phase < TM_PHASE_COUNT; ++phase)
+    {
+        record->phaseTimes[phase] = TmGetPhaseStats(tm, (TmFramePhase)phase).last;
+    }
+    const TmPerfCounters* perf = TmGetPerfCounters(tm);
+    if (perf)
+    {
+        // TmBeginFrame samples the counters and thread usage before recording, so these are the frame's
+        const TmPerfFrameCounters counters = TmPerfCountersGetFrame(perf);
+        record->perfAvailable = counters.available;
+        memcpy(record->perfCounters, counters.values, sizeof record->perfCounters);
+    }
+    const TmThreadUsage* usage = TmGetThreadUsage(tm);
+    if (usage)
+    {
+        const TmThreadFrameUsage thread = TmThreadUsageGetFrame(usage);
+        record->threadCpuTime = thread.cpuTime;
+        record->threadWaitTime = thread.waitTime;
+        record->minorFaults = thread.minorFaults;
+        record->majorFaults = thread.majorFaults;
+    }
+    recorder->next = (recorder->next + 1) % recorder->config.capacity;
+    if (recorder->count < recorder->config.capacity)
+    {
+        recorder->count++;
+    }
+
+    if (recorder->triggered)
+    {
+        if (--recorder->postFramesLeft == 0)
+        {
+            Freeze(recorder);
+        }
+    }
+    else if (hitch != TM_HITCH_NONE && (recorder->config.triggerMask & (1u << hitch)))
+    {
+        recorder->triggered = true;
+        recorder->triggerKind = hitch;
+        recorder->triggerFrame = frameIndex;
+        recorder->postFramesLeft = recorder->config.postTriggerFrames;
+        if (recorder->postFramesLeft == 0)
+        {
+            Freeze(recorder);
+        }
+    }
+    return hitch;
+}
+
+bool TmFlightRecorderIsFrozen(const TmFlightRecorder* recorder)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    return recorder->frozen;
+}
+
+void TmFlightRecorderRearm(TmFlightRecorder* recorder)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    recorder->frozen = false;
+    recorder->triggered = false;
+    recorder->triggerKind = TM_HITCH_NONE;
+}
+
+size_t TmFlightRecorderCount(const TmFlightRecorder* recorder)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    return recorder->count;
+}
+
+bool TmFlightRecorderGet(const TmFlightRecorder* recorder, const size_t index, TmFlightRecord* record)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    assert(record != NULL && "record pointer is null!");
+    if (index >= recorder->count)
+    {
+        return false;
+    }
+    const size_t capacity = recorder->config.capacity;
+    *record = recorder->records[(recorder->next + capacity - recorder->count + index) % capacity];
+    return true;
+}
+
+TmHitchStats TmFlightRecorderGetStats(const TmFlightRecorder* recorder)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    TmHitchStats stats = recorder->stats;
+    stats.baselineFrameTime = recorder->baseline;
+    return stats;
+}
+
+size_t TmFlightRecorderDumpSize(const TmFlightRecorder* recorder)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    return TM_FLIGHT_RECORDER_HEADER_SIZE + recorder->count * TM_FLIGHT_RECORD_SERIALIZED_SIZE;
+}
+
+static unsigned char* PutHeader(const TmFlightRecorder* recorder, unsigned char* p)
+{
+    p = PutU32(p, FLIGHT_RECORDER_MAGIC);
+    p = PutU16(p, FLIGHT_RECORDER_VERSION);
+    p = PutU16(p, (uint16_t)recorder->triggerKind);
+    p = PutU32(p, (uint32_t)recorder->count);
+    p = PutU32(p, TM_FLIGHT_RECORD_SERIALIZED_SIZE);
+    p = PutU64(p, recorder->triggerFrame);
+    return p;
+}
+
+static unsigned char* PutRecord(const TmFlightRecord* record, unsigned char* p)
+{
+    p = PutU64(p, record->frameIndex);
+    p = PutU64(p, (uint64_t)record->startNs);
+    p = PutU64(p, record->tick);
+    p = PutF64(p, record->rawFrameTime);
+    p = PutF64(p, record->frameTime);
+    p = PutF64(p, record->droppedTime);
+    p = PutF64(p, record->presentInterval);
+    p = PutU32(p, record->physicsSteps);
+    p = PutU32(p, record->lagging ? 1u : 0u);
+    p = PutU32(p, record->phaseBudgetExceeded);
+    p = PutU32(p, (uint32_t)record->hitch);
+    for (int phase = 0; phase < TM_PHASE_COUNT; ++phase)
+    {
+        p = PutF64(p, record->phaseTimes[phase]);
+    }
+    p = PutU32(p, record->perfAvailable);
+    for (int counter = 0; counter < TM_PERF_COUNTER_COUNT; ++counter)
+    {
+        p = PutU64(p, record->perfCounters[counter]);
+    }
+    p = PutF64(p, record->threadCpuTime);
+    p = PutF64(p, record->threadWaitTime);
+    p = PutU64(p, record->minorFaults);
+    p = PutU64(p, record->majorFaults);
+    return p;
+}
+
+size_t TmFlightRecorderDump(const TmFlightRecorder* recorder, void* buffer, const size_t bufferSize)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    if (buffer == NULL || bufferSize < TmFlightRecorderDumpSize(recorder))
+    {
+        return 0;
+    }
+
+    unsigned char* p = PutHeader(recorder, buffer);
+    for (size_t i = 0; i < recorder->count; ++i)
+    {
+        TmFlightRecord record;
+        TmFlightRecorderGet(recorder, i, &record);
+        p = PutRecord(&record, p);
+    }
+    return (size_t)(p - (unsigned char*)buffer);
+}
+
+bool TmFlightRecorderDumpToFile(const TmFlightRecorder* recorder, const char* path)
+{
+    assert(recorder != NULL && "TmFlightRecorder pointer is null!");
+    assert(path != NULL && "path pointer is null!");
+
+    FILE* file = NULL;
+#ifdef _MSC_VER
+    if (fopen_s(&file, path, "wb") != 0)
+    {
+        file = NULL;
+    }
+#else
+    file = fopen(path, "wb");
+#endif
+    if (!file)
+    {
+        return false;
+    }
+
+    unsigned char chunk[DUMP_CHUNK_RECORDS * TM_FLIGHT_RECORD_SERIALIZED_SIZE];
+    bool ok = fwrite(chunk, 1, (size_t)(PutHeader(recorder, chunk) - chunk), file) == TM_FLIGHT_RECORDER_HEADER_SIZE;
+    for (size_t i = 0; ok && i < recorder->count; i += DUMP_CHUNK_RECORDS)
+    {
+        unsigned char* p = chunk;
+        for (size_t j = i; j < recorder->count && j < i + DUMP_CHUNK_RECORDS; ++j)
+        {
+            TmFlightRecord record;
+            TmFlightRecorderGet(recorder, j, &record);
+            p = PutRecord(&record, p);
+        }
+        const size_t size = (size_t)(p - chunk);
+        ok = fwrite(chunk, 1, size, file) == size;
+    }
+    return fclose(file) == 0 && ok;
+}
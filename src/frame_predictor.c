@@ -0,0 +1,162 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/frame_predictor.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// Samples further than this many standard deviations above the mean are clipped before they
+// update the model, so a single loading hitch does not drag the scale down for seconds
+static const double OUTLIER_DEVIATIONS = 4.0;
+// Relative scale changes smaller than this are ignored to keep the scale from flickering
+static const double SCALE_DEADBAND = 0.01;
+
+struct TmFramePredictor
+{
+    TmFramePredictorConfig config;
+    double z;
+    // Mean and variance of the cost normalized to quality scale 1
+    double mean;
+    double variance;
+    double scale;
+    bool hasSample;
+};
+
+// Standard normal quantile by bisection on the CDF; only run once per predictor
+static double NormalQuantile(const double p)
+{
+    double lo = -10.0;
+    double hi = 10.0;
+    for (int i = 0; i < 100; ++i)
+    {
+        const double mid = 0.5 * (lo + hi);
+        if (0.5 * erfc(-mid / sqrt(2.0)) < p)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+TmFramePredictor* TmFramePredictorCreate(const TmFramePredictorConfig* config)
+{
+    assert(config != NULL && "config pointer is null!");
+    if (!(config->targetFrameTime > 0.0) || !(config->percentile >= 0.5) || !(config->percentile < 1.0)
+        || !(config->minScale > 0.0) || !(config->maxScale >= config->minScale) || !(config->qualityExponent > 0.0)
+        || !(config->smoothing > 0.0) || !(config->smoothing <= 1.0) || !(config->maxScaleStep > 0.0))
+    {
+        return NULL;
+    }
+
+    TmFramePredictor* predictor = calloc(1, sizeof *predictor);
+    if (!predictor)
+    {
+        return NULL;
+    }
+    predictor->config = *config;
+    predictor->z = NormalQuantile(config->percentile);
+    predictor->scale = config->maxScale;
+    return predictor;
+}
+
+void TmFramePredictorDestroy(TmFramePredictor* predictor)
+{
+    free(predictor);
+}
+
+// Cost multiplier of a quality scale relative to scale 1
+static inline double ScaleCost(const TmFramePredictor* predictor, const double scale)
+{
+    return pow(scale, predictor->config.qualityExponent);
+}
+
+void TmFramePredictorObserve(TmFramePredictor* predictor, const double frameCost)
+{
+    assert(predictor != NULL && "TmFramePredictor pointer is null!");
+    if (!(frameCost > 0.0))
+    {
+        return;
+    }
+
+    const TmFramePredictorConfig* config = &predictor->config;
+    double sample = frameCost / ScaleCost(predictor, predictor->scale);
+    if (!predictor->hasSample)
+    {
+        predictor->mean = sample;
+        predictor->variance = 0.0;
+        predictor->hasSample = true;
+    }
+    else
+    {
+        const double limit = predictor->mean + OUTLIER_DEVIATIONS * sqrt(predictor->variance);
+        if (predictor->variance > 0.0 && sample > limit)
+        {
+            sample = limit;
+        }
+
+        // Exponentially weighted mean and variance (West / Finch incremental form)
+        const double diff = sample - predictor->mean;
+        const double increment = config->smoothing * diff;
+        predictor->mean += increment;
+        predictor->variance = (1.0 - config->smoothing) * (predictor->variance + diff * increment);
+    }
+
+    // Largest scale whose percentile cost fits the budget, approached a bounded step at a time
+    const double upper = predictor->mean + predictor->z * sqrt(predictor->variance);
+    double wanted = pow(config->targetFrameTime / upper, 1.0 / config->qualityExponent);
+    wanted = fmin(fmax(wanted, config->minScale), config->maxScale);
+
+    // Bounds are always reachable so the scale can settle exactly at full quality
+    const double ratio = wanted / predictor->scale;
+    if (fabs(ratio - 1.0) < SCALE_DEADBAND && wanted > config->minScale && wanted < config->maxScale)
+    {
+        return;
+    }
+    const double step = fmin(fmax(ratio, 1.0 - config->maxScaleStep), 1.0 + config->maxScaleStep);
+    predictor->scale = fmin(fmax(predictor->scale * step, config->minScale), config->maxScale);
+}
+
+double TmFramePredictorObserveFrame(TmFramePredictor* predictor, const TimeManager* tm, const FrameTimingData* frame)
+{
+    assert(predictor != NULL && "TmFramePredictor pointer is null!");
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(frame != NULL && "frame pointer is null!");
+
+    double cost = 0.0;
+    for (int phase = 0; phase < TM_PHASE_COUNT; ++phase)
+    {
+        if (phase != TM_PHASE_PRESENT)
+        {
+            cost += TmGetPhaseStats(tm, (TmFramePhase)phase).last;
+        }
+    }
+    if (!(cost > 0.0))
+    {
+        cost = frame->rawFrameTime;
+    }
+
+    TmFramePredictorObserve(predictor, cost);
+    return cost;
+}
+
+TmFramePrediction TmFramePredictorPredict(const TmFramePredictor* predictor)
+{
+    assert(predictor != NULL && "TmFramePredictor pointer is null!");
+    const double factor = ScaleCost(predictor, predictor->scale);
+    const double stddev = sqrt(predictor->variance) * factor;
+    const double expected = predictor->mean * factor;
+    return (TmFramePrediction){
+        .expected = expected,
+        .upperBound = expected + predictor->z * stddev,
+        .stddev = stddev,
+        .qualityScale = predictor->scale
+    };
+}
@@ -0,0 +1,194 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/idle_scheduler.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static const double NANOSECONDS_PER_SECOND = 1000000000.0;
+
+// Distinct task functions whose cost is learned; must be a power of two
+#define COST_TABLE_SIZE 64
+
+// Cost estimation as for TCP retransmission timeouts (RFC 6298): smoothed mean plus four
+// smoothed mean deviations, which keeps overruns rare without being as pessimistic as the max
+static const double COST_MEAN_GAIN = 0.125;
+static const double COST_DEVIATION_GAIN = 0.25;
+static const double COST_DEVIATION_WEIGHT = 4.0;
+
+typedef struct
+{
+    TmIdleTaskFn fn;
+    void* userData;
+} IdleTask;
+
+typedef struct
+{
+    TmIdleTaskFn fn;
+    double mean;
+    double deviation;
+} TaskCost;
+
+struct TmIdleScheduler
+{
+    IdleTask* tasks;
+    size_t capacity;
+    size_t count;
+    double targetFrameTime;
+    double margin;
+    TaskCost costs[COST_TABLE_SIZE];
+    TmIdleSchedulerStats stats;
+};
+
+TmIdleScheduler* TmIdleSchedulerCreate(const size_t capacity, const double targetFrameTime, const double margin)
+{
+    if (capacity == 0 || !(targetFrameTime > 0.0) || !(margin >= 0.0) || capacity > SIZE_MAX / sizeof(IdleTask))
+    {
+        return NULL;
+    }
+
+    TmIdleScheduler* scheduler = calloc(1, sizeof *scheduler);
+    if (!scheduler)
+    {
+        return NULL;
+    }
+
+    scheduler->tasks = malloc(capacity * sizeof *scheduler->tasks);
+    if (!scheduler->tasks)
+    {
+        free(scheduler);
+        return NULL;
+    }
+    scheduler->capacity = capacity;
+    scheduler->targetFrameTime = targetFrameTime;
+    scheduler->margin = margin;
+    return scheduler;
+}
+
+void TmIdleSchedulerDestroy(TmIdleScheduler* scheduler)
+{
+    if (scheduler == NULL)
+    {
+        return;
+    }
+    free(scheduler->tasks);
+    free(scheduler);
+}
+
+void TmIdleSchedulerSetBudget(TmIdleScheduler* scheduler, const double targetFrameTime, const double margin)
+{
+    assert(scheduler != NULL && "TmIdleScheduler pointer is null!");
+    assert(targetFrameTime > 0.0 && margin >= 0.0 && "targetFrameTime must be > 0 and margin >= 0");
+    scheduler->targetFrameTime = targetFrameTime;
+    scheduler->margin = margin;
+}
+
+bool TmIdleSchedulerPost(TmIdleScheduler* scheduler, const TmIdleTaskFn taskFn, void* userData)
+{
+    assert(scheduler != NULL && "TmIdleScheduler pointer is null!");
+    assert(taskFn != NULL && "taskFn pointer is null!");
+    if (scheduler->count == scheduler->capacity)
+    {
+        return false;
+    }
+    scheduler->tasks[scheduler->count++] = (IdleTask){taskFn, userData};
+    return true;
+}
+
+// Slot for a task function: its own entry, else an empty one, else its home slot is recycled
+static size_t FindCostSlot(const TmIdleScheduler* scheduler, const TmIdleTaskFn fn)
+{
+    const size_t home = (size_t)(((uintptr_t)fn >> 4) * 0x9E3779B97F4A7C15ull >> 32) & (COST_TABLE_SIZE - 1);
+    for (size_t i = 0; i < COST_TABLE_SIZE; ++i)
+    {
+        const size_t slot = (home + i) & (COST_TABLE_SIZE - 1);
+        if (scheduler->costs[slot].fn == fn || scheduler->costs[slot].fn == NULL)
+        {
+            return slot;
+        }
+    }
+    return home;
+}
+
+static double EstimateOf(const TaskCost* cost, const TmIdleTaskFn fn)
+{
+    return cost->fn == fn ? cost->mean + COST_DEVIATION_WEIGHT * cost->deviation : 0.0;
+}
+
+static void LearnCost(TaskCost* cost, const TmIdleTaskFn fn, const double duration)
+{
+    if (cost->fn != fn)
+    {
+        *cost = (TaskCost){.fn = fn, .mean = duration, .deviation = duration / 2.0};
+        return;
+    }
+    cost->deviation += (fabs(duration - cost->mean) - cost->deviation) * COST_DEVIATION_GAIN;
+    cost->mean += (duration - cost->mean) * COST_MEAN_GAIN;
+}
+
+size_t TmIdleSchedulerRun(TmIdleScheduler* scheduler, const TimeManager* tm)
+{
+    assert(scheduler != NULL && "TmIdleScheduler pointer is null!");
+    assert(tm != NULL && "TimeManager pointer is null!");
+
+    const long long deadline = TmGetFrameStartTime(tm).nanoseconds
+                               + llround((scheduler->targetFrameTime - scheduler->margin) * NANOSECONDS_PER_SECOND);
+    long long now = TmNow(tm).nanoseconds;
+    scheduler->stats.lastBudget = deadline > now ? (double)(deadline - now) / NANOSECONDS_PER_SECOND : 0.0;
+
+    // Tasks kept for later are compacted towards the front; tasks posted while running land after
+    // the scanned range and are moved down afterwards
+    const size_t scanned = scheduler->count;
+    size_t kept = 0;
+    size_t run = 0;
+    for (size_t i = 0; i < scanned; ++i)
+    {
+        const IdleTask task = scheduler->tasks[i];
+        const double remaining = (double)(deadline - now) / NANOSECONDS_PER_SECOND;
+        if (remaining <= 0.0 || EstimateOf(&scheduler->costs[FindCostSlot(scheduler, task.fn)], task.fn) > remaining)
+        {
+            scheduler->tasks[kept++] = task;
+            scheduler->stats.tasksDeferred += remaining > 0.0 ? 1 : 0;
+            continue;
+        }
+
+        task.fn(task.userData);
+        const long long end = TmNow(tm).nanoseconds;
+        const double duration = (double)(end - now) / NANOSECONDS_PER_SECOND;
+        LearnCost(&scheduler->costs[FindCostSlot(scheduler, task.fn)], task.fn, duration);
+        scheduler->stats.timeUsed += duration;
+        scheduler->stats.tasksRun++;
+        scheduler->stats.overruns += end > deadline ? 1 : 0;
+        now = end;
+        run++;
+    }
+
+    for (size_t i = scanned; i < scheduler->count; ++i)
+    {
+        scheduler->tasks[kept++] = scheduler->tasks[i];
+    }
+    scheduler->count = kept;
+    return run;
+}
+
+size_t TmIdleSchedulerPending(const TmIdleScheduler* scheduler)
+{
+    assert(scheduler != NULL && "TmIdleScheduler pointer is null!");
+    return scheduler->count;
+}
+
+double TmIdleSchedulerEstimate(const TmIdleScheduler* scheduler, const TmIdleTaskFn taskFn)
+{
+    assert(scheduler != NULL && "TmIdleScheduler pointer is null!");
+    return EstimateOf(&scheduler->costs[FindCostSlot(scheduler, taskFn)], taskFn);
+}
+
+TmIdleSchedulerStats TmIdleSchedulerGetStats(const TmIdleScheduler* scheduler)
+{
+    assert(scheduler != NULL && "TmIdleScheduler pointer is null!");
+    return scheduler->stats;
+}
@@ -0,0 +1,233 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/input_queue.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "atomic_compat.h"
+
+// Keeps the producer and consumer positions on separate cache lines
+#define CACHE_LINE_SIZE 64
+
+// Bounded MPMC ring (Vyukov), used with a single consumer. A cell is free for the producer that
+// claims position pos when its sequence equals pos, and holds an event when it equals pos + 1.
+typedef struct
+{
+    TmAtomicSize sequence;
+    HighResTimeT timestamp;
+} InputCell;
+
+struct TmInputQueue
+{
+    TmAtomicSize enqueuePos;
+    char padEnqueue[CACHE_LINE_SIZE - sizeof(TmAtomicSize)];
+    size_t dequeuePos;
+    char padDequeue[CACHE_LINE_SIZE - sizeof(size_t)];
+
+    InputCell* cells;
+    unsigned char* cellData;
+    size_t mask;
+    size_t eventSize;
+    HighResTimeT (*now)(void);
+
+    // Consumer side: events taken off the ring, kept sorted by timestamp in order[0, pendingCount)
+    unsigned char* pendingData;
+    HighResTimeT* pendingTime;
+    size_t* order;
+    size_t* freeSlots;
+    size_t pendingCount;
+    size_t freeCount;
+};
+
+static size_t RoundUpPow2(const size_t value)
+{
+    size_t pow2 = 2;
+    while (pow2 < value && pow2 <= SIZE_MAX / 2)
+    {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
+
+TmInputQueue* TmInputQueueCreate(const size_t capacity, const size_t eventSize, HighResTimeT (*nowFn)(void))
+{
+    if (capacity == 0 || eventSize == 0)
+    {
+        return NULL;
+    }
+
+    const size_t slots = RoundUpPow2(capacity);
+    if (slots > SIZE_MAX / eventSize || slots > SIZE_MAX / sizeof(InputCell))
+    {
+        return NULL;
+    }
+
+    TmInputQueue* queue = calloc(1, sizeof *queue);
+    if (!queue)
+    {
+        return NULL;
+    }
+
+    queue->cells = malloc(slots * sizeof *queue->cells);
+    queue->cellData = malloc(slots * eventSize);
+    queue->pendingData = malloc(slots * eventSize);
+    queue->pendingTime = malloc(slots * sizeof *queue->pendingTime);
+    queue->order = malloc(slots * sizeof *queue->order);
+    queue->freeSlots = malloc(slots * sizeof *queue->freeSlots);
+    if (!queue->cells || !queue->cellData || !queue->pendingData || !queue->pendingTime || !queue->order
+        || !queue->freeSlots)
+    {
+        TmInputQueueDestroy(queue);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < slots; ++i)
+    {
+        queue->cells[i].sequence = i;
+        queue->freeSlots[i] = slots - 1 - i;
+    }
+    queue->freeCount = slots;
+    queue->mask = slots - 1;
+    queue->eventSize = eventSize;
+    queue->now = nowFn ? nowFn : GetHighResolutionTime;
+    return queue;
+}
+
+void TmInputQueueDestroy(TmInputQueue* queue)
+{
+    if (queue == NULL)
+    {
+        return;
+    }
+    free(queue->cells);
+    free(queue->cellData);
+    free(queue->pendingData);
+    free(queue->pendingTime);
+    free(queue->order);
+    free(queue->freeSlots);
+    free(queue);
+}
+
+bool TmInputQueuePushAt(TmInputQueue* queue, const void* event, const HighResTimeT timestamp)
+{
+    assert(queue != NULL && "TmInputQueue pointer is null!");
+    assert(event != NULL && "event pointer is null!");
+
+    size_t pos = TmAtomicLoadRelaxed(&queue->enqueuePos);
+    InputCell* cell;
+    for (;;)
+    {
+        cell = &queue->cells[pos & queue->mask];
+        const ptrdiff_t lap = (ptrdiff_t)(TmAtomicLoadAcquire(&cell->sequence) - pos);
+        if (lap == 0)
+        {
+            if (TmAtomicCompareExchange(&queue->enqueuePos, &pos, pos + 1))
+            {
+                break;
+            }
+        }
+        else if (lap < 0)
+        {
+            // The consumer has not released this cell from the previous lap yet
+            return false;
+        }
+        else
+        {
+            pos = TmAtomicLoadRelaxed(&queue->enqueuePos);
+        }
+    }
+
+    cell->timestamp = timestamp;
+    memcpy(queue->cellData + (pos & queue->mask) * queue->eventSize, event, queue->eventSize);
+    TmAtomicStoreRelease(&cell->sequence, pos + 1);
+    return true;
+}
+
+bool TmInputQueuePush(TmInputQueue* queue, const void* event)
+{
+    assert(queue != NULL && "TmInputQueue pointer is null!");
+    return TmInputQueuePushAt(queue, event, queue->now());
+}
+
+// Moves published events off the ring into the sorted pending set, as far as pending slots allow
+static void CollectEvents(TmInputQueue* queue)
+{
+    while (queue->freeCount > 0)
+    {
+        const size_t pos = queue->dequeuePos;
+        InputCell* cell = &queue->cells[pos & queue->mask];
+        if (TmAtomicLoadAcquire(&cell->sequence) != pos + 1)
+        {
+            return;
+        }
+
+        const size_t slot = queue->freeSlots[--queue->freeCount];
+        const HighResTimeT timestamp = cell->timestamp;
+        memcpy(queue->pendingData + slot * queue->eventSize, queue->cellData + (pos & queue->mask) * queue->eventSize,
+               queue->eventSize);
+        TmAtomicStoreRelease(&cell->sequence, pos + queue->mask + 1);
+        queue->dequeuePos = pos + 1;
+
+        // Producers race, so arrival order is only roughly timestamp order; insert from the back.
+        // Equal timestamps keep arrival order.
+        size_t i = queue->pendingCount;
+        while (i > 0 && queue->pendingTime[queue->order[i - 1]].nanoseconds > timestamp.nanoseconds)
+        {
+            queue->order[i] = queue->order[i - 1];
+            i--;
+        }
+        queue->order[i] = slot;
+        queue->pendingTime[slot] = timestamp;
+        queue->pendingCount++;
+    }
+}
+
+size_t TmInputQueueDispatch(TmInputQueue* queue, const TimeManager* tm, const uint64_t tick,
+                            const TmInputFn eventFn, void* userData)
+{
+    assert(queue != NULL && "TmInputQueue pointer is null!");
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(eventFn != NULL && "eventFn pointer is null!");
+
+    size_t total = 0;
+    for (;;)
+    {
+        CollectEvents(queue);
+
+        // Timestamps map to ticks monotonically, so the due events are a prefix of the sorted set
+        size_t dispatched = 0;
+        while (dispatched < queue->pendingCount)
+        {
+            const size_t slot = queue->order[dispatched];
+            const HighResTimeT timestamp = queue->pendingTime[slot];
+            const TmTickPosition at = TmMapTimestampToTick(tm, timestamp);
+            if (at.tick > tick)
+            {
+                break;
+            }
+            eventFn(userData, queue->pendingData + slot * queue->eventSize, timestamp, at.tick);
+            queue->freeSlots[queue->freeCount++] = slot;
+            dispatched++;
+        }
+
+        if (dispatched == 0)
+        {
+            return total;
+        }
+        queue->pendingCount -= dispatched;
+        memmove(queue->order, queue->order + dispatched, queue->pendingCount * sizeof *queue->order);
+        total += dispatched;
+
+        // Freed pending slots may let more events in from the ring
+    }
+}
+
+size_t TmInputQueuePending(const TmInputQueue* queue)
+{
+    assert(queue != NULL && "TmInputQueue pointer is null!");
+    return queue->pendingCount;
+}
@@ -0,0 +1,294 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/jitter_buffer.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "time_manager/tick_history.h"
+
+static const double NANOSECONDS_PER_SECOND_D = 1e9;
+// Playback delay error that is corrected at 1x + 100% speed; smaller errors warp proportionally less
+static const double RATE_ADJUST_TIME_NS = 1e9;
+// Weight of a new gap in the snapshot interval estimate
+static const double INTERVAL_SMOOTHING = 0.1;
+
+struct TmJitterBuffer
+{
+    TmTickHistory* snapshots;
+    uint64_t capacity;
+    double tickNs;
+    double percentile;
+    double minDelayNs;
+    double maxDelayNs;
+    double maxRateAdjust;
+
+    // Transit times (arrival minus server time) of the most recent arrivals
+    double* transits;
+    double* scratch;
+    size_t windowSize;
+    size_t windowCount;
+    size_t windowNext;
+    double minTransitNs;
+    double jitterNs;
+    double intervalNs;
+    double targetDelayNs;
+
+    uint64_t newestTick;
+    bool hasSnapshot;
+
+    // Position on the server timeline being rendered
+    double playbackNs;
+    int64_t lastSampleNs;
+    bool playing;
+
+    size_t received;
+    size_t late;
+    size_t underruns;
+};
+
+static int CompareDoubles(const void* a, const void* b)
+{
+    const double lhs = *(const double*)a;
+    const double rhs = *(const double*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static double ClampDouble(const double value, const double lo, const double hi)
+{
+    return value < lo ? lo : (value > hi ? hi : value);
+}
+
+TmJitterBuffer* TmJitterBufferCreate(const TmJitterBufferConfig* config)
+{
+    assert(config != NULL && "config pointer is null!");
+    if (config->capacity == 0 || config->recordSize == 0 || config->windowSize == 0 || config->serverTickRate <= 0.0
+        || config->percentile <= 0.0 || config->percentile > 1.0 || config->minDelay < 0.0
+        || config->maxDelay < config->minDelay || config->maxRateAdjust < 0.0 || config->maxRateAdjust >= 1.0
+        || config->windowSize > SIZE_MAX / sizeof(double))
+    {
+        return NULL;
+    }
+
+    TmJitterBuffer* buffer = calloc(1, sizeof *buffer);
+    if (!buffer)
+    {
+        return NULL;
+    }
+
+    buffer->snapshots = TmTickHistoryCreate(config->capacity, config->recordSize);
+    buffer->transits = malloc(config->windowSize * sizeof *buffer->transits);
+    buffer->scratch = malloc(config->windowSize * sizeof *buffer->scratch);
+    if (!buffer->snapshots || !buffer->transits || !buffer->scratch)
+    {
+        TmJitterBufferDestroy(buffer);
+        return NULL;
+    }
+
+    buffer->capacity = TmTickHistoryCapacity(buffer->snapshots);
+    buffer->tickNs = NANOSECONDS_PER_SECOND_D / config->serverTickRate;
+    buffer->percentile = config->percentile;
+    buffer->minDelayNs = config->minDelay * NANOSECONDS_PER_SECOND_D;
+    buffer->maxDelayNs = config->maxDelay * NANOSECONDS_PER_SECOND_D;
+    buffer->maxRateAdjust = config->maxRateAdjust;
+    buffer->windowSize = config->windowSize;
+    return buffer;
+}
+
+void TmJitterBufferDestroy(TmJitterBuffer* buffer)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+    TmTickHistoryDestroy(buffer->snapshots);
+    free(buffer->transits);
+    free(buffer->scratch);
+    free(buffer);
+}
+
+static void UpdateJitter(TmJitterBuffer* buffer, const double transitNs)
+{
+    buffer->transits[buffer->windowNext] = transitNs;
+    buffer->windowNext = (buffer->windowNext + 1) % buffer->windowSize;
+    if (buffer->windowCount < buffer->windowSize)
+    {
+        buffer->windowCount++;
+    }
+
+    // The fastest arrival in the window anchors the clock offset; the spread above it is jitter
+    for (size_t i = 0; i < buffer->windowCount; ++i)
+    {
+        buffer->scratch[i] = buffer->transits[i];
+    }
+    qsort(buffer->scratch, buffer->windowCount, sizeof *buffer->scratch, CompareDoubles);
+
+    size_t rank = (size_t)ceil(buffer->percentile * (double)buffer->windowCount);
+    rank = rank == 0 ? 0 : rank - 1;
+    buffer->minTransitNs = buffer->scratch[0];
+    buffer->jitterNs = buffer->scratch[rank] - buffer->scratch[0];
+
+    // One snapshot interval is needed to have something to interpolate towards
+    const double delay = buffer->intervalNs + fmax(buffer->jitterNs, buffer->minDelayNs);
+    buffer->targetDelayNs = fmin(delay, buffer->maxDelayNs);
+}
+
+void TmJitterBufferPush(TmJitterBuffer* buffer, const uint64_t serverTick, const HighResTimeT arrival,
+                        const void* snapshot)
+{
+    assert(buffer != NULL && "TmJitterBuffer pointer is null!");
+    assert(snapshot != NULL && "snapshot pointer is null!");
+
+    const double serverNs = (double)serverTick * buffer->tickNs;
+    if (buffer->playing && serverNs < buffer->playbackNs)
+    {
+        buffer->late++;
+    }
+
+    // Too old to keep without evicting something newer
+    if (buffer->hasSnapshot && serverTick + buffer->capacity <= buffer->newestTick)
+    {
+        return;
+    }
+
+    TmTickHistoryPush(buffer->snapshots, serverTick, snapshot);
+    buffer->received++;
+
+    if (!buffer->hasSnapshot || serverTick > buffer->newestTick)
+    {
+        if (buffer->hasSnapshot)
+        {
+            const double gapNs = (double)(serverTick - buffer->newestTick) * buffer->tickNs;
+            buffer->intervalNs = buffer->intervalNs == 0.0
+                                     ? gapNs
+                                     : buffer->intervalNs + (gapNs - buffer->intervalNs) * INTERVAL_SMOOTHING;
+        }
+        buffer->newestTick = serverTick;
+        buffer->hasSnapshot = true;
+    }
+
+    UpdateJitter(buffer, (double)arrival.nanoseconds - serverNs);
+}
+
+static void AdvancePlayback(TmJitterBuffer* buffer, const int64_t nowNs)
+{
+    // Newest server time that could have arrived by now
+    const double freshestNs = (double)nowNs - buffer->minTransitNs;
+
+    if (!buffer->playing)
+    {
+        buffer->playbackNs = freshestNs - buffer->targetDelayNs;
+        buffer->lastSampleNs = nowNs;
+        buffer->playing = true;
+        return;
+    }
+
+    const double elapsedNs = nowNs > buffer->lastSampleNs ? (double)(nowNs - buffer->lastSampleNs) : 0.0;
+    buffer->lastSampleNs = nowNs;
+
+    // Warp playback speed towards the target delay instead of jumping, so motion never snaps or stalls
+    const double errorNs = freshestNs - (buffer->playbackNs + elapsedNs) - buffer->targetDelayNs;
+    if (fabs(errorNs) > buffer->maxDelayNs + buffer->intervalNs)
+    {
+        // Too far off to recover smoothly, e.g. after a long hitch
+        buffer->playbackNs = freshestNs - buffer->targetDelayNs;
+        return;
+    }
+
+    const double rate = 1.0 + ClampDouble(errorNs / RATE_ADJUST_TIME_NS, -buffer->maxRateAdjust,
+                                          buffer->maxRateAdjust);
+    buffer->playbackNs += elapsedNs * rate;
+}
+
+bool TmJitterBufferSample(TmJitterBuffer* buffer, const HighResTimeT now, TmJitterSample* sample)
+{
+    assert(buffer != NULL && "TmJitterBuffer pointer is null!");
+    assert(sample != NULL && "sample pointer is null!");
+
+    // The target delay includes the snapshot interval, which takes two snapshots to measure
+    if (buffer->intervalNs == 0.0)
+    {
+        return false;
+    }
+
+    AdvancePlayback(buffer, now.nanoseconds);
+
+    sample->delay = ((double)now.nanoseconds - buffer->minTransitNs - buffer->playbackNs) / NANOSECONDS_PER_SECOND_D;
+    sample->targetDelay = buffer->targetDelayNs / NANOSECONDS_PER_SECOND_D;
+    sample->underrun = false;
+
+    const uint64_t newest = buffer->newestTick;
+    const double position = buffer->playbackNs / buffer->tickNs;
+    const uint64_t oldest = newest >= buffer->capacity - 1 ? newest - (buffer->capacity - 1) : 0;
+
+    if (position >= (double)newest)
+    {
+        // Hold the newest snapshot while playback keeps moving; the delay adapts to late arrivals
+        sample->underrun = position > (double)newest;
+        if (sample->underrun)
+        {
+            buffer->underruns++;
+        }
+        sample->from = sample->to = TmTickHistoryGet(buffer->snapshots, newest);
+        sample->fromTick = sample->toTick = newest;
+        sample->alpha = 0.0;
+        return true;
+    }
+
+    uint64_t from = position > (double)oldest ? (uint64_t)position : oldest;
+    const void* fromRecord = NULL;
+    for (uint64_t tick = from;; --tick)
+    {
+        if ((fromRecord = TmTickHistoryGet(buffer->snapshots, tick)))
+        {
+            from = tick;
+            break;
+        }
+        if (tick == oldest)
+        {
+            break;
+        }
+    }
+
+    // The newest snapshot is always present, so a later one can always be found
+    uint64_t to = fromRecord ? from + 1 : from;
+    const void* toRecord = NULL;
+    for (; to <= newest; ++to)
+    {
+        if ((toRecord = TmTickHistoryGet(buffer->snapshots, to)))
+        {
+            break;
+        }
+    }
+
+    if (!fromRecord)
+    {
+        // Playback is before every retained snapshot; hold the oldest one
+        sample->from = sample->to = toRecord;
+        sample->fromTick = sample->toTick = to;
+        sample->alpha = 0.0;
+        return true;
+    }
+
+    sample->from = fromRecord;
+    sample->to = toRecord;
+    sample->fromTick = from;
+    sample->toTick = to;
+    sample->alpha = ClampDouble((position - (double)from) / (double)(to - from), 0.0, 1.0);
+    return true;
+}
+
+TmJitterBufferStats TmJitterBufferGetStats(const TmJitterBuffer* buffer)
+{
+    assert(buffer != NULL && "TmJitterBuffer pointer is null!");
+    return (TmJitterBufferStats){
+        .received = buffer->received,
+        .late = buffer->late,
+        .underruns = buffer->underruns,
+        .jitter = buffer->jitterNs / NANOSECONDS_PER_SECOND_D,
+        .snapshotInterval = buffer->intervalNs / NANOSECONDS_PER_SECOND_D
+    };
+}
@@ -0,0 +1,275 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "time_manager/lag_attribution.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define LAG_PATH_SIZE 512
+// Enough for cpu.stat; of /proc/stat only the first (aggregate) line is needed
+#define LAG_READ_SIZE 1024
+
+typedef struct
+{
+    uint64_t throttledUsec;
+    uint64_t throttledPeriods;
+    uint64_t stealTicks;
+    uint64_t totalTicks;
+} LagReading;
+
+struct TmLagAttribution
+{
+    int cpuStatFd;
+    int procStatFd;
+    LagReading last;
+    double refreshInterval;
+    // Wall time since the sources were last read
+    double windowTime;
+    TmLagAttributionStats stats;
+};
+
+#ifdef __linux__
+static const char* const DEFAULT_PROC_STAT_PATH = "/proc/stat";
+
+static bool ReadSource(const int fd, char* buffer, const size_t size)
+{
+    const ssize_t length = pread(fd, buffer, size - 1, 0);
+    if (length <= 0)
+    {
+        return false;
+    }
+    buffer[length] = '\0';
+    return true;
+}
+
+// Value of a "key value" line, as in cpu.stat
+static bool FindStatValue(const char* text, const char* key, uint64_t* value)
+{
+    const size_t keyLength = strlen(key);
+    const char* line = text;
+    while (line != NULL)
+    {
+        if (strncmp(line, key, keyLength) == 0 && line[keyLength] == ' ')
+        {
+            *value = strtoull(line + keyLength + 1, NULL, 10);
+            return true;
+        }
+        line = strchr(line, '\n');
+        line = line ? line + 1 : NULL;
+    }
+    return false;
+}
+
+static bool ReadCpuStat(const int fd, LagReading* reading)
+{
+    char buffer[LAG_READ_SIZE];
+    return ReadSource(fd, buffer, sizeof buffer)
+           && FindStatValue(buffer, "nr_throttled", &reading->throttledPeriods)
+           && FindStatValue(buffer, "throttled_usec", &reading->throttledUsec);
+}
+
+// "cpu  user nice system idle iowait irq softirq steal ..." in clock ticks
+static bool ReadProcStat(const int fd, LagReading* reading)
+{
+    char buffer[LAG_READ_SIZE];
+    if (!ReadSource(fd, buffer, sizeof buffer) || strncmp(buffer, "cpu ", 4) != 0)
+    {
+        return false;
+    }
+    const char* p = buffer + 4;
+    uint64_t total = 0;
+    uint64_t steal = 0;
+    for (int column = 0; column < 8; ++column)
+    {
+        char* end = NULL;
+        const uint64_t value = strtoull(p, &end, 10);
+        if (end == p)
+        {
+            return false;
+        }
+        total += value;
+        steal = value;
+        p = end;
+    }
+    reading->stealTicks = steal;
+    reading->totalTicks = total;
+    return true;
+}
+
+// Finds the process's cgroup v2 directory from the "0::" line of /proc/self/cgroup
+static bool FindCpuStatPath(char* path, const size_t size)
+{
+    FILE* file = fopen("/proc/self/cgroup", "r");
+    if (!file)
+    {
+        return false;
+    }
+    char line[LAG_PATH_SIZE];
+    bool found = false;
+    while (!found && fgets(line, sizeof line, file))
+    {
+        if (strncmp(line, "0::", 3) == 0)
+        {
+            line[strcspn(line, "\n")] = '\0';
+            const char* group = strcmp(line + 3, "/") == 0 ? "" : line + 3;
+            found = snprintf(path, size, "/sys/fs/cgroup%s/cpu.stat", group) < (int)size;
+        }
+    }
+    fclose(file);
+    return found;
+}
+
+static int OpenSource(const char* path)
+{
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+#endif
+
+static uint64_t Delta(const uint64_t now, const uint64_t last)
+{
+    // Counters only go backwards when the source was replaced, e.g. the cgroup was recreated
+    return now >= last ? now - last : 0;
+}
+
+TmLagAttribution* TmLagAttributionCreate(const TmLagAttributionConfig* config)
+{
+    TmLagAttribution* attribution = calloc(1, sizeof *attribution);
+    if (!attribution)
+    {
+        return NULL;
+    }
+    attribution->cpuStatFd = -1;
+    attribution->procStatFd = -1;
+    const TmLagAttributionConfig defaults = TmLagAttributionDefaultConfig();
+    attribution->refreshInterval = fmax(config ? config->refreshInterval : defaults.refreshInterval, 0.0);
+
+#ifdef __linux__
+    char cpuStatPath[LAG_PATH_SIZE];
+    const char* cpuStat = config && config->cpuStatPath ? config->cpuStatPath : NULL;
+    if (!cpuStat && FindCpuStatPath(cpuStatPath, sizeof cpuStatPath))
+    {
+        cpuStat = cpuStatPath;
+    }
+    if (cpuStat)
+    {
+        attribution->cpuStatFd = OpenSource(cpuStat);
+        attribution->stats.hasThrottling =
+            attribution->cpuStatFd != -1 && ReadCpuStat(attribution->cpuStatFd, &attribution->last);
+    }
+
+    const char* procStat = config && config->procStatPath ? config->procStatPath : DEFAULT_PROC_STAT_PATH;
+    attribution->procStatFd = OpenSource(procStat);
+    attribution->stats.hasSteal =
+        attribution->procStatFd != -1 && ReadProcStat(attribution->procStatFd, &attribution->last);
+#else
+    (void)config;
+#endif
+    return attribution;
+}
+
+void TmLagAttributionDestroy(TmLagAttribution* attribution)
+{
+    if (attribution == NULL)
+    {
+        return;
+    }
+#ifdef __linux__
+    if (attribution->cpuStatFd != -1)
+    {
+        close(attribution->cpuStatFd);
+    }
+    if (attribution->procStatFd != -1)
+    {
+        close(attribution->procStatFd);
+    }
+#endif
+    free(attribution);
+}
+
+TmLagFrameAttribution TmLagAttributionRecord(TmLagAttribution* attribution, const FrameTimingData* frame)
+{
+    assert(attribution != NULL && "TmLagAttribution pointer is null!");
+    assert(frame != NULL && "frame pointer is null!");
+
+    TmLagFrameAttribution result;
+    memset(&result, 0, sizeof result);
+    result.frameTime = fmax(frame->rawFrameTime, 0.0);
+    result.lagging = frame->lagging;
+
+    TmLagAttributionStats* stats = &attribution->stats;
+    stats->frames++;
+    attribution->windowTime += result.frameTime;
+    if (!frame->lagging && attribution->windowTime < attribution->refreshInterval)
+    {
+        return result;
+    }
+
+    // A failed read keeps the previous values, so the window sees no change from that source
+    LagReading now = attribution->last;
+#ifdef __linux__
+    if (attribution->stats.hasThrottling)
+    {
+        (void)ReadCpuStat(attribution->cpuStatFd, &now);
+    }
+    if (attribution->stats.hasSteal)
+    {
+        (void)ReadProcStat(attribution->procStatFd, &now);
+    }
+#endif
+    const LagReading* last = &attribution->last;
+    const double windowTime = attribution->windowTime;
+
+    // Throttling in the window is charged to this frame first, as the frame most likely to have suffered it
+    const double windowThrottled = fmin((double)Delta(now.throttledUsec, last->throttledUsec) / 1e6, windowTime);
+    const uint64_t totalTicks = Delta(now.totalTicks, last->totalTicks);
+    const double stealFraction =
+        totalTicks > 0 ? (double)Delta(now.stealTicks, last->stealTicks) / (double)totalTicks : 0.0;
+    result.sampled = true;
+    result.throttledTime = fmin(windowThrottled, result.frameTime);
+    result.stealTime = fmin(result.frameTime * stealFraction, result.frameTime - result.throttledTime);
+
+    stats->throttledTime += windowThrottled;
+    stats->stealTime += fmin(windowTime * stealFraction, windowTime - windowThrottled);
+    stats->throttledPeriods += Delta(now.throttledPeriods, last->throttledPeriods);
+
+    if (frame->lagging)
+    {
+        result.lostTime = fmax(frame->droppedTime, 0.0);
+        if (result.frameTime > 0.0)
+        {
+            result.lostToThrottling = result.lostTime * result.throttledTime / result.frameTime;
+            result.lostToSteal = result.lostTime * result.stealTime / result.frameTime;
+        }
+        result.lostToOther = fmax(result.lostTime - result.lostToThrottling - result.lostToSteal, 0.0);
+
+        stats->lagFrames++;
+        stats->lostTime += result.lostTime;
+        stats->lostToThrottling += result.lostToThrottling;
+        stats->lostToSteal += result.lostToSteal;
+        stats->lostToOther += result.lostToOther;
+    }
+
+    attribution->last = now;
+    attribution->windowTime = 0.0;
+    return result;
+}
+
+TmLagAttributionStats TmLagAttributionGetStats(const TmLagAttribution* attribution)
+{
+    assert(attribution != NULL && "TmLagAttribution pointer is null!");
+    return attribution->stats;
+}
@@ -0,0 +1,216 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "time_manager/perf_counters.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct TmPerfCounters
+{
+    int leader;
+    int fds[TM_PERF_COUNTER_COUNT];
+    uint32_t available;
+    // Group position -> TmPerfCounter, in the order the kernel reports values
+    size_t groupSize;
+    int order[TM_PERF_COUNTER_COUNT];
+
+    uint64_t last[TM_PERF_COUNTER_COUNT];
+    uint64_t lastEnabled;
+    uint64_t lastRunning;
+    TmPerfFrameCounters frame;
+};
+
+#ifdef __linux__
+typedef struct
+{
+    uint32_t type;
+    uint64_t config;
+    // Kernel-side counts need perf_event_paranoid < 2; user-only counts are the fallback
+    bool tryKernel;
+} PerfEventSpec;
+
+static const PerfEventSpec PERF_EVENTS[TM_PERF_COUNTER_COUNT] = {
+    [TM_PERF_CYCLES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, false},
+    [TM_PERF_INSTRUCTIONS] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, false},
+    [TM_PERF_LLC_MISSES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, false},
+    [TM_PERF_CONTEXT_SWITCHES] = {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, true},
+};
+
+static int OpenEvent(const PerfEventSpec* spec, const int groupFd, const bool excludeKernel)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof attr);
+    attr.size = sizeof attr;
+    attr.type = spec->type;
+    attr.config = spec->config;
+    attr.disabled = groupFd == -1;
+    attr.exclude_kernel = excludeKernel;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // This thread, any CPU
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+}
+
+// Reads the cumulative group values; false if the group could not be read
+static bool ReadGroup(const TmPerfCounters* counters, uint64_t values[TM_PERF_COUNTER_COUNT], uint64_t* enabled,
+                      uint64_t* running)
+{
+    uint64_t buffer[3 + TM_PERF_COUNTER_COUNT];
+    const ssize_t expected = (ssize_t)((3 + counters->groupSize) * sizeof(uint64_t));
+    if (read(counters->leader, buffer, sizeof buffer) < expected || buffer[0] != counters->groupSize)
+    {
+        return false;
+    }
+    *enabled = buffer[1];
+    *running = buffer[2];
+    for (size_t i = 0; i < counters->groupSize; ++i)
+    {
+        values[counters->order[i]] = buffer[3 + i];
+    }
+    return true;
+}
+
+static void OpenGroup(TmPerfCounters* counters)
+{
+    for (int counter = 0; counter < TM_PERF_COUNTER_COUNT; ++counter)
+    {
+        const PerfEventSpec* spec = &PERF_EVENTS[counter];
+        int fd = spec->tryKernel ? OpenEvent(spec, counters->leader, false) : -1;
+        if (fd == -1)
+        {
+            fd = OpenEvent(spec, counters->leader, true);
+        }
+        if (fd == -1)
+        {
+            continue;
+        }
+        if (counters->leader == -1)
+        {
+            counters->leader = fd;
+        }
+        counters->fds[counter] = fd;
+        counters->order[counters->groupSize++] = counter;
+        counters->available |= 1u << counter;
+    }
+    if (counters->leader == -1)
+    {
+        return;
+    }
+
+    ioctl(counters->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    if (!ReadGroup(counters, counters->last, &counters->lastEnabled, &counters->lastRunning))
+    {
+        counters->available = 0;
+    }
+}
+#endif
+
+TmPerfCounters* TmPerfCountersCreate(void)
+{
+    TmPerfCounters* counters = calloc(1, sizeof *counters);
+    if (!counters)
+    {
+        return NULL;
+    }
+    counters->leader = -1;
+    for (int counter = 0; counter < TM_PERF_COUNTER_COUNT; ++counter)
+    {
+        counters->fds[counter] = -1;
+    }
+#ifdef __linux__
+    OpenGroup(counters);
+#endif
+    return counters;
+}
+
+void TmPerfCountersDestroy(TmPerfCounters* counters)
+{
+    if (counters == NULL)
+    {
+        return;
+    }
+#ifdef __linux__
+    for (int counter = 0; counter < TM_PERF_COUNTER_COUNT; ++counter)
+    {
+        if (counters->fds[counter] != -1)
+        {
+            close(counters->fds[counter]);
+        }
+    }
+#endif
+    free(counters);
+}
+
+uint32_t TmPerfCountersAvailable(const TmPerfCounters* counters)
+{
+    assert(counters != NULL && "TmPerfCounters pointer is null!");
+    return counters->available;
+}
+
+TmPerfFrameCounters TmPerfCountersSample(TmPerfCounters* counters)
+{
+    assert(counters != NULL && "TmPerfCounters pointer is null!");
+    TmPerfFrameCounters frame;
+    memset(&frame, 0, sizeof frame);
+
+#ifdef __linux__
+    uint64_t values[TM_PERF_COUNTER_COUNT] = {0};
+    uint64_t enabled = 0;
+    uint64_t running = 0;
+    if (counters->available == 0 || !ReadGroup(counters, values, &enabled, &running))
+    {
+        counters->frame = frame;
+        return frame;
+    }
+
+    // Scale up when the kernel multiplexed the group off the PMU for part of the frame
+    const uint64_t enabledDelta = enabled - counters->lastEnabled;
+    const uint64_t runningDelta = running - counters->lastRunning;
+    const double scale = runningDelta > 0 ? (double)enabledDelta / (double)runningDelta : 0.0;
+    frame.running = enabledDelta > 0 ? (double)runningDelta / (double)enabledDelta : 1.0;
+    frame.available = counters->available;
+    for (int counter = 0; counter < TM_PERF_COUNTER_COUNT; ++counter)
+    {
+        if (counters->available & (1u << counter))
+        {
+            const uint64_t delta = values[counter] - counters->last[counter];
+            frame.values[counter] = runningDelta == enabledDelta ? delta : (uint64_t)((double)delta * scale);
+            counters->last[counter] = values[counter];
+        }
+    }
+    counters->lastEnabled = enabled;
+    counters->lastRunning = running;
+
+    const uint32_t ipcMask = (1u << TM_PERF_CYCLES) | (1u << TM_PERF_INSTRUCTIONS);
+    if ((frame.available & ipcMask) == ipcMask && frame.values[TM_PERF_CYCLES] > 0)
+    {
+        frame.instructionsPerCycle =
+            (double)frame.values[TM_PERF_INSTRUCTIONS] / (double)frame.values[TM_PERF_CYCLES];
+    }
+#endif
+
+    counters->frame = frame;
+    return frame;
+}
+
+TmPerfFrameCounters TmPerfCountersGetFrame(const TmPerfCounters* counters)
+{
+    assert(counters != NULL && "TmPerfCounters pointer is null!");
+    return counters->frame;
+}
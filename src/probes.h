@@ -0,0 +1,37 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_PROBES_H
+#define TIME_MANAGER_PROBES_H
+
+// USDT probes under the "time_manager" provider, for bpftrace, perf and SystemTap. Each probe is
+// a single nop in the instruction stream plus an ELF note describing where its arguments live,
+// so it costs nothing until a tracer attaches. Arguments are integers because most tracers cannot
+// read floating point registers; durations are nanoseconds and the time scale is in millionths.
+// Without <sys/sdt.h> (TIME_MANAGER_HAVE_SDT undefined) or below TM_STATS_TRACING the probes
+// compile to nothing and their arguments are not evaluated.
+//
+//   frame_begin(tick, rawFrameNs, frameNs, physicsSteps, lagging)
+//   steps_computed(tick, physicsSteps, accumulatorNs)
+//   lag_detected(tick, physicsSteps, droppedNs)
+//   time_scale_changed(timeScaleMicros)
+
+#include "time_manager/time_manager.h"
+
+#if defined(TIME_MANAGER_HAVE_SDT) && TM_STATS_LEVEL >= TM_STATS_TRACING
+#include <sys/sdt.h>
+
+#define TM_PROBE1(name, a) DTRACE_PROBE1(time_manager, name, a)
+#define TM_PROBE3(name, a, b, c) DTRACE_PROBE3(time_manager, name, a, b, c)
+#define TM_PROBE5(name, a, b, c, d, e) DTRACE_PROBE5(time_manager, name, a, b, c, d, e)
+#else
+#define TM_PROBE1(name, a) ((void)0)
+#define TM_PROBE3(name, a, b, c) ((void)0)
+#define TM_PROBE5(name, a, b, c, d, e) ((void)0)
+#endif
+
+// Seconds to whole nanoseconds for probe arguments
+#define TM_PROBE_NS(seconds) ((long long)((seconds) * 1e9))
+
+#endif //TIME_MANAGER_PROBES_H
@@ -0,0 +1,122 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/rate_limiter.h"
+
+#include "accumulator.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+struct TmRateLimiter
+{
+    // Parallel arrays so the refill loop is a straight pass the compiler can vectorize
+    double* tokens;
+    double* rate;
+    double* burst;
+    size_t count;
+};
+
+TmRateLimiter* TmRateLimiterCreate(const size_t bucketCount, const double rate, const double burst)
+{
+    if (bucketCount == 0 || rate < 0.0 || burst <= 0.0 || bucketCount > SIZE_MAX / sizeof(double))
+    {
+        return NULL;
+    }
+
+    TmRateLimiter* limiter = malloc(sizeof *limiter);
+    if (!limiter)
+    {
+        return NULL;
+    }
+
+    limiter->tokens = malloc(bucketCount * sizeof *limiter->tokens);
+    limiter->rate = malloc(bucketCount * sizeof *limiter->rate);
+    limiter->burst = malloc(bucketCount * sizeof *limiter->burst);
+    if (!limiter->tokens || !limiter->rate || !limiter->burst)
+    {
+        TmRateLimiterDestroy(limiter);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < bucketCount; ++i)
+    {
+        limiter->tokens[i] = burst;
+        limiter->rate[i] = rate;
+        limiter->burst[i] = burst;
+    }
+    limiter->count = bucketCount;
+    return limiter;
+}
+
+void TmRateLimiterDestroy(TmRateLimiter* limiter)
+{
+    if (limiter == NULL)
+    {
+        return;
+    }
+    free(limiter->tokens);
+    free(limiter->rate);
+    free(limiter->burst);
+    free(limiter);
+}
+
+size_t TmRateLimiterBucketCount(const TmRateLimiter* limiter)
+{
+    assert(limiter != NULL && "TmRateLimiter pointer is null!");
+    return limiter->count;
+}
+
+void TmRateLimiterSetBucket(TmRateLimiter* limiter, const size_t bucket, const double rate, const double burst)
+{
+    assert(limiter != NULL && "TmRateLimiter pointer is null!");
+    assert(bucket < limiter->count && "bucket out of range!");
+    assert(rate >= 0.0 && burst > 0.0 && "rate must be >= 0 and burst > 0");
+    limiter->rate[bucket] = rate;
+    limiter->burst[bucket] = burst;
+    if (limiter->tokens[bucket] > burst)
+    {
+        limiter->tokens[bucket] = burst;
+    }
+}
+
+void TmRateLimiterResetBucket(TmRateLimiter* limiter, const size_t bucket)
+{
+    assert(limiter != NULL && "TmRateLimiter pointer is null!");
+    assert(bucket < limiter->count && "bucket out of range!");
+    limiter->tokens[bucket] = limiter->burst[bucket];
+}
+
+void TmRateLimiterRefill(TmRateLimiter* limiter, const double elapsed)
+{
+    assert(limiter != NULL && "TmRateLimiter pointer is null!");
+    if (!(elapsed > 0.0))
+    {
+        return;
+    }
+
+    double* tokens = limiter->tokens;
+    const double* rate = limiter->rate;
+    const double* burst = limiter->burst;
+    for (size_t i = 0; i < limiter->count; ++i)
+    {
+        const double filled = tokens[i] + rate[i] * elapsed;
+        tokens[i] = filled < burst[i] ? filled : burst[i];
+    }
+}
+
+bool TmRateLimiterTryConsume(TmRateLimiter* limiter, const size_t bucket, const double tokens)
+{
+    assert(limiter != NULL && "TmRateLimiter pointer is null!");
+    assert(bucket < limiter->count && "bucket out of range!");
+
+    return ConsumeUnits(&limiter->tokens[bucket], tokens);
+}
+
+double TmRateLimiterTokens(const TmRateLimiter* limiter, const size_t bucket)
+{
+    assert(limiter != NULL && "TmRateLimiter pointer is null!");
+    assert(bucket < limiter->count && "bucket out of range!");
+    return limiter->tokens[bucket];
+}
@@ -0,0 +1,71 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifndef TIME_MANAGER_THREAD_COMPAT_H
+#define TIME_MANAGER_THREAD_COMPAT_H
+
+#include <stdbool.h>
+
+// Just enough threading for background writers: Win32 threads on Windows, pthreads elsewhere.
+// Thread procedures are declared with TM_THREAD_PROC and return TM_THREAD_EXIT.
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+typedef HANDLE TmThread;
+typedef DWORD(WINAPI* TmThreadProc)(LPVOID);
+#define TM_THREAD_PROC(name, arg) DWORD WINAPI name(LPVOID arg)
+#define TM_THREAD_EXIT 0
+
+static inline bool TmThreadStart(TmThread* thread, const TmThreadProc proc, void* arg)
+{
+    *thread = CreateThread(NULL, 0, proc, arg, 0, NULL);
+    return *thread != NULL;
+}
+
+static inline void TmThreadJoin(const TmThread thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+static inline void TmSleepMs(const unsigned milliseconds)
+{
+    Sleep(milliseconds);
+}
+#else
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+typedef pthread_t TmThread;
+typedef void* (*TmThreadProc)(void*);
+#define TM_THREAD_PROC(name, arg) void* name(void* arg)
+#define TM_THREAD_EXIT NULL
+
+static inline bool TmThreadStart(TmThread* thread, const TmThreadProc proc, void* arg)
+{
+    return pthread_create(thread, NULL, proc, arg) == 0;
+}
+
+static inline void TmThreadJoin(const TmThread thread)
+{
+    pthread_join(thread, NULL);
+}
+
+static inline void TmSleepMs(const unsigned milliseconds)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(milliseconds / 1000u);
+    ts.tv_nsec = (long)(milliseconds % 1000u) * 1000000L;
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+}
+#endif
+
+#endif //TIME_MANAGER_THREAD_COMPAT_H
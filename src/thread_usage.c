@@ -0,0 +1,140 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "time_manager/thread_usage.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+typedef struct
+{
+    long long cpuNs;
+    uint64_t minorFaults;
+    uint64_t majorFaults;
+    uint64_t voluntarySwitches;
+    uint64_t involuntarySwitches;
+    // Whether the fault and context switch counts were read
+    bool hasFaults;
+} ThreadReading;
+
+struct TmThreadUsage
+{
+    ThreadReading last;
+    TmThreadFrameUsage frame;
+    // The next sample only takes a baseline
+    bool restart;
+};
+
+static void ReadThread(ThreadReading* reading)
+{
+    memset(reading, 0, sizeof *reading);
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernel, user;
+    if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernel, &user))
+    {
+        const ULONGLONG kernel100Ns = ((ULONGLONG)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+        const ULONGLONG user100Ns = ((ULONGLONG)user.dwHighDateTime << 32) | user.dwLowDateTime;
+        reading->cpuNs = (long long)(kernel100Ns + user100Ns) * 100;
+    }
+#else
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    {
+        reading->cpuNs = ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    }
+#endif
+#ifdef __linux__
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0)
+    {
+        reading->minorFaults = (uint64_t)usage.ru_minflt;
+        reading->majorFaults = (uint64_t)usage.ru_majflt;
+        reading->voluntarySwitches = (uint64_t)usage.ru_nvcsw;
+        reading->involuntarySwitches = (uint64_t)usage.ru_nivcsw;
+        reading->hasFaults = true;
+    }
+#endif
+}
+
+TmThreadUsage* TmThreadUsageCreate(void)
+{
+    TmThreadUsage* usage = calloc(1, sizeof *usage);
+    if (!usage)
+    {
+        return NULL;
+    }
+    ReadThread(&usage->last);
+    return usage;
+}
+
+void TmThreadUsageDestroy(TmThreadUsage* usage)
+{
+    free(usage);
+}
+
+TmThreadFrameUsage TmThreadUsageSample(TmThreadUsage* usage, const double wallTime)
+{
+    assert(usage != NULL && "TmThreadUsage pointer is null!");
+
+    ThreadReading now;
+    ReadThread(&now);
+    const ThreadReading* last = &usage->last;
+
+    TmThreadFrameUsage frame;
+    memset(&frame, 0, sizeof frame);
+    if (usage->restart)
+    {
+        usage->restart = false;
+        usage->last = now;
+        usage->frame = frame;
+        return frame;
+    }
+    frame.wallTime = fmax(wallTime, 0.0);
+    frame.cpuTime = now.cpuNs > last->cpuNs ? (double)(now.cpuNs - last->cpuNs) / 1e9 : 0.0;
+    frame.waitTime = fmax(frame.wallTime - frame.cpuTime, 0.0);
+    // A failed reading would make the unsigned deltas wrap: report nothing for the frame instead
+    frame.hasFaults = now.hasFaults && last->hasFaults;
+    if (frame.hasFaults)
+    {
+        frame.minorFaults = now.minorFaults - last->minorFaults;
+        frame.majorFaults = now.majorFaults - last->majorFaults;
+        frame.voluntarySwitches = now.voluntarySwitches - last->voluntarySwitches;
+        frame.involuntarySwitches = now.involuntarySwitches - last->involuntarySwitches;
+    }
+
+    usage->last = now;
+    usage->frame = frame;
+    return frame;
+}
+
+void TmThreadUsageRestart(TmThreadUsage* usage)
+{
+    assert(usage != NULL && "TmThreadUsage pointer is null!");
+    usage->restart = true;
+    memset(&usage->frame, 0, sizeof usage->frame);
+}
+
+TmThreadFrameUsage TmThreadUsageGetFrame(const TmThreadUsage* usage)
+{
+    assert(usage != NULL && "TmThreadUsage pointer is null!");
+    return usage->frame;
+}
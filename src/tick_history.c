@@ -0,0 +1,144 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/tick_history.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Records start on this boundary so callers can store any type
+static const size_t RECORD_ALIGNMENT = 16;
+static const uint64_t EMPTY_TICK = UINT64_MAX;
+
+struct TmTickHistory
+{
+    unsigned char* records;
+    uint64_t* ticks;
+    size_t mask;
+    size_t stride;
+    size_t recordSize;
+};
+
+static size_t RoundUpPow2(const size_t value)
+{
+    size_t pow2 = 1;
+    while (pow2 < value && pow2 <= SIZE_MAX / 2)
+    {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
+
+TmTickHistory* TmTickHistoryCreate(const size_t capacity, const size_t recordSize)
+{
+    if (capacity == 0 || recordSize == 0 || recordSize > SIZE_MAX - RECORD_ALIGNMENT)
+    {
+        return NULL;
+    }
+
+    const size_t slots = RoundUpPow2(capacity);
+    const size_t stride = (recordSize + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+    if (slots > SIZE_MAX / stride)
+    {
+        return NULL;
+    }
+
+    TmTickHistory* history = malloc(sizeof *history);
+    if (!history)
+    {
+        return NULL;
+    }
+
+    history->records = malloc(slots * stride);
+    history->ticks = malloc(slots * sizeof *history->ticks);
+    if (!history->records || !history->ticks)
+    {
+        free(history->records);
+        free(history->ticks);
+        free(history);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < slots; ++i)
+    {
+        history->ticks[i] = EMPTY_TICK;
+    }
+    history->mask = slots - 1;
+    history->stride = stride;
+    history->recordSize = recordSize;
+    return history;
+}
+
+void TmTickHistoryDestroy(TmTickHistory* history)
+{
+    if (history == NULL)
+    {
+        return;
+    }
+    free(history->records);
+    free(history->ticks);
+    free(history);
+}
+
+void* TmTickHistoryWrite(TmTickHistory* history, const uint64_t tick)
+{
+    assert(history != NULL && "TmTickHistory pointer is null!");
+    assert(tick != EMPTY_TICK && "tick out of range!");
+    const size_t slot = (size_t)tick & history->mask;
+    history->ticks[slot] = tick;
+    return history->records + slot * history->stride;
+}
+
+void TmTickHistoryPush(TmTickHistory* history, const uint64_t tick, const void* record)
+{
+    assert(record != NULL && "record pointer is null!");
+    memcpy(TmTickHistoryWrite(history, tick), record, history->recordSize);
+}
+
+const void* TmTickHistoryGet(const TmTickHistory* history, const uint64_t tick)
+{
+    assert(history != NULL && "TmTickHistory pointer is null!");
+    const size_t slot = (size_t)tick & history->mask;
+    return history->ticks[slot] == tick ? history->records + slot * history->stride : NULL;
+}
+
+bool TmTickHistorySample(const TmTickHistory* history, const TimeManager* tm, const int64_t simTimeNs,
+                         TmHistorySample* sample)
+{
+    assert(history != NULL && "TmTickHistory pointer is null!");
+    assert(sample != NULL && "sample pointer is null!");
+
+    const TmTickPosition position = TmGetTickAtSimTime(tm, simTimeNs);
+    const void* from = TmTickHistoryGet(history, position.tick);
+    if (!from)
+    {
+        return false;
+    }
+
+    const void* to = position.fraction > 0.0 ? TmTickHistoryGet(history, position.tick + 1) : from;
+    if (!to)
+    {
+        return false;
+    }
+
+    sample->from = from;
+    sample->to = to;
+    sample->fromTick = position.tick;
+    sample->toTick = to == from ? position.tick : position.tick + 1;
+    sample->alpha = position.fraction;
+    return true;
+}
+
+size_t TmTickHistoryCapacity(const TmTickHistory* history)
+{
+    assert(history != NULL && "TmTickHistory pointer is null!");
+    return history->mask + 1;
+}
+
+size_t TmTickHistoryRecordSize(const TmTickHistory* history)
+{
+    assert(history != NULL && "TmTickHistory pointer is null!");
+    return history->recordSize;
+}
@@ -3,16 +3,34 @@
 //
 
 #include "time_manager/time_manager.h"
+#include "time_manager/flight_recorder.h"
+#include "time_manager/lag_attribution.h"
+#include "time_manager/perf_counters.h"
+#include "time_manager/thread_usage.h"
+#include "time_manager/trace_exporter.h"
+
+#include "accumulator.h"
+#include "byte_order.h"
+#include "probes.h"
 
 #include <assert.h>
 #include <float.h>
 #include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 static const double NANOSECONDS_PER_SECOND = 1000000000.0;
 static const double FPS_CALCULATION_THRESHOLD = 1.0; // seconds
-static const double FLOATING_POINT_EPSILON = 1e-12;
+static const long long NANOSECONDS_PER_SECOND_LL = 1000000000LL;
+static const uint32_t TIMING_STATE_MAGIC = 0x54534D54u; // "TMST"
+static const uint16_t TIMING_STATE_VERSION = 2;
+static const double PRESENT_SMOOTHING = 0.1;
+
+// Frames of wall-clock to sim-time anchors kept for mapping timestamps to ticks
+#define FRAME_HISTORY_SIZE 16
+// Frames of per-phase timings the rolling phase statistics cover
+#define PHASE_WINDOW_SIZE 64
 
 struct TimeManager
 {
@@ -28,6 +46,8 @@ struct TimeManager
     size_t physicsHz;
     size_t maxPhysicsSteps;
     size_t physicsStepsThisFrame;
+    TmRenderMode renderMode;
+    double maxExtrapolationAlpha;
 
     // Statistics (accessed even less frequently)
     double averageFps;
@@ -35,15 +55,242 @@ struct TimeManager
     size_t fpsFrameCount;
     double timeScaleBeforePause;
 
+    // Simulation clock. The timestep is kept as the exact fraction stepNumNs / stepDen nanoseconds,
+    // and sim time is computed from the tick relative to the last timestep change so it never drifts.
+    uint64_t tick;
+    uint64_t baseTick;
+    int64_t baseSimTimeNs;
+    uint64_t stepNumNs;
+    uint64_t stepDen;
+    int64_t unscaledTimeNs;
+
+    // Substepping
+    struct
+    {
+        size_t divisor;
+        size_t maxSubsteps;
+        TmStiffnessFn metricFn;
+        void* metricUserData;
+        size_t stepsThisFrame;
+        size_t substepsThisFrame;
+        size_t maxThisFrame;
+        size_t totalSteps;
+        size_t totalSubsteps;
+    } substep;
+
+    // Run-ahead
+    struct
+    {
+        size_t steps;
+        TmRunAheadCallbacks callbacks;
+        bool active;
+        TmRunAheadStats stats;
+        double totalTime;
+        size_t frames;
+    } runAhead;
+
+    // Prediction and reconciliation
+    TmResimulationStats resim;
+    double resimTotalTime;
+
+    // Wall time and sim time at the end of each recent TmBeginFrame, oldest first from next - count
+    struct
+    {
+        int64_t wallNs[FRAME_HISTORY_SIZE];
+        int64_t simNs[FRAME_HISTORY_SIZE];
+        size_t next;
+        size_t count;
+    } frameHistory;
+
+    // Frame phase profiling. Phase times are summed over the frame and rolled into the window
+    // at the next TmBeginFrame; frames in which no phase was marked record zero for every phase.
+    struct
+    {
+        long long beginNs[TM_PHASE_COUNT];
+        long long frameNs[TM_PHASE_COUNT];
+        double budget[TM_PHASE_COUNT];
+        double last[TM_PHASE_COUNT];
+        size_t overBudget[TM_PHASE_COUNT];
+        double window[TM_PHASE_COUNT][PHASE_WINDOW_SIZE];
+        size_t windowNext;
+        size_t windowCount;
+        uint32_t open;
+    } phases;
+
+    // Present-to-present tracking
+    struct
+    {
+        long long lastNs;
+        double refreshPeriod;
+        size_t swapInterval;
+        size_t lastRefreshes;
+        TmPresentStats stats;
+    } present;
+
+    // Optional recorders fed every frame
+    TmFlightRecorder* flightRecorder;
+    TmTraceExporter* traceExporter;
+    TmPerfCounters* perfCounters;
+    TmThreadUsage* threadUsage;
+    TmLagAttribution* lagAttribution;
+
     // Flags (pack together at the end)
     bool firstFrame;
 };
 
+static inline double SecondsBetween(const HighResTimeT from, const HighResTimeT to)
+{
+    return (double)(to.nanoseconds - from.nanoseconds) / NANOSECONDS_PER_SECOND;
+}
+
 static inline double Clamp(const double x, const double min, const double max)
 {
     return fmax(fmin(x, max), min);
 }
 
+// Turns the accumulator into whole steps (at most maxSteps) and keeps only the < dt remainder.
+static size_t ConsumeAccumulator(TimeManager* tm, const size_t maxSteps, bool* lagging)
+{
+    const double stepsD = WholeUnits(tm->accumulator, tm->physicsTimeStep);
+    *lagging = stepsD > (double)maxSteps;
+    const size_t steps = *lagging ? maxSteps : (size_t)stepsD;
+
+    double remainder = fmod(tm->accumulator, tm->physicsTimeStep);
+    if (remainder < 0.0)
+    {
+        remainder += tm->physicsTimeStep;
+    }
+
+    // The epsilon above already counted a step for a remainder this close to dt; don't count it twice
+    if (remainder + FLOATING_POINT_EPSILON >= tm->physicsTimeStep)
+    {
+        remainder = 0.0;
+    }
+
+    tm->accumulator = remainder;
+    return steps;
+}
+
+// Interpolation factor for the render mode; above 1 when extrapolating past the latest step
+static inline double RenderAlpha(const TimeManager* tm, const double accumulator)
+{
+    const double alpha = accumulator / tm->physicsTimeStep;
+    if (tm->renderMode == TM_RENDER_EXTRAPOLATE)
+    {
+        return Clamp(1.0 + alpha, 1.0, tm->maxExtrapolationAlpha);
+    }
+    return Clamp(alpha, 0.0, 1.0);
+}
+
+// Seconds of simulation time the render time lies past the latest completed step
+static inline double ExtrapolationTime(const TimeManager* tm, const double alpha)
+{
+    return tm->renderMode == TM_RENDER_EXTRAPOLATE ? (alpha - 1.0) * tm->physicsTimeStep : 0.0;
+}
+
+// Duration of a number of ticks at the current timestep, in nanoseconds
+static inline int64_t TickSpanNs(const TimeManager* tm, const uint64_t ticks)
+{
+    // Split into whole and partial denominators so ticks * stepNumNs cannot overflow
+    const uint64_t whole = (ticks / tm->stepDen) * tm->stepNumNs;
+    const uint64_t partial = (ticks % tm->stepDen) * tm->stepNumNs / tm->stepDen;
+    return (int64_t)(whole + partial);
+}
+
+static inline int64_t SimTimeAtTick(const TimeManager* tm, const uint64_t tick)
+{
+    return tick >= tm->baseTick ? tm->baseSimTimeNs + TickSpanNs(tm, tick - tm->baseTick)
+                                : tm->baseSimTimeNs - TickSpanNs(tm, tm->baseTick - tick);
+}
+
+// Sim time the render position is at: the latest tick plus the accumulator
+static inline int64_t CurrentSimTimeNs(const TimeManager* tm)
+{
+    return SimTimeAtTick(tm, tm->tick) + llround(tm->accumulator * NANOSECONDS_PER_SECOND);
+}
+
+static void RecordFrameAnchor(TimeManager* tm)
+{
+    tm->frameHistory.wallNs[tm->frameHistory.next] = tm->lastTime.nanoseconds;
+    tm->frameHistory.simNs[tm->frameHistory.next] = CurrentSimTimeNs(tm);
+    tm->frameHistory.next = (tm->frameHistory.next + 1) % FRAME_HISTORY_SIZE;
+    if (tm->frameHistory.count < FRAME_HISTORY_SIZE)
+    {
+        tm->frameHistory.count++;
+    }
+}
+
+// Steps issued outside TmBeginFrame happen at the latest frame's wall time. The second anchor at the
+// same wall time keeps earlier timestamps on the frame's own steps and later ones after the new steps.
+static void ReanchorFrameHistory(TimeManager* tm)
+{
+    if (tm->frameHistory.count > 0)
+    {
+        RecordFrameAnchor(tm);
+    }
+}
+
+#if TM_STATS_LEVEL >= TM_STATS_BASIC
+// Rolls this frame's phase times into the statistics and returns the phases over budget
+static uint32_t EndFramePhases(TimeManager* tm, const long long nowNs)
+{
+    uint32_t exceeded = 0;
+    for (int phase = 0; phase < TM_PHASE_COUNT; ++phase)
+    {
+        // Split phases that span the frame boundary
+        if (tm->phases.open & (1u << phase))
+        {
+            tm->phases.frameNs[phase] += nowNs - tm->phases.beginNs[phase];
+            tm->phases.beginNs[phase] = nowNs;
+        }
+
+        const double seconds = (double)tm->phases.frameNs[phase] / NANOSECONDS_PER_SECOND;
+        tm->phases.last[phase] = seconds;
+        #if TM_STATS_LEVEL >= TM_STATS_HISTOGRAM
+        tm->phases.window[phase][tm->phases.windowNext] = seconds;
+        #endif
+        tm->phases.frameNs[phase] = 0;
+        if (tm->phases.budget[phase] > 0.0 && seconds > tm->phases.budget[phase])
+        {
+            exceeded |= 1u << phase;
+            tm->phases.overBudget[phase]++;
+        }
+    }
+
+    #if TM_STATS_LEVEL >= TM_STATS_HISTOGRAM
+    tm->phases.windowNext = (tm->phases.windowNext + 1) % PHASE_WINDOW_SIZE;
+    if (tm->phases.windowCount < PHASE_WINDOW_SIZE)
+    {
+        tm->phases.windowCount++;
+    }
+    #endif
+    return exceeded;
+}
+#endif
+
+// Reports a time scale change to the probe and the trace exporter
+static void TimeScaleChanged(const TimeManager* tm)
+{
+    #if TM_STATS_LEVEL >= TM_STATS_TRACING
+    TM_PROBE1(time_scale_changed, llround(tm->timeScale * 1e6));
+    if (tm->traceExporter)
+    {
+        TmTraceExporterRecordTimeScale(tm->traceExporter, tm->now().nanoseconds, tm->timeScale);
+    }
+    #else
+    (void)tm;
+    #endif
+}
+
+// Starts a new segment of the sim clock, called whenever the timestep changes
+static void RebaseSimClock(TimeManager* tm, const uint64_t stepNumNs, const uint64_t stepDen)
+{
+    tm->baseSimTimeNs = SimTimeAtTick(tm, tm->tick);
+    tm->baseTick = tm->tick;
+    tm->stepNumNs = stepNumNs > 0 ? stepNumNs : 1;
+    tm->stepDen = stepDen > 0 ? stepDen : 1;
+}
+
 void UpdateFpsStats(TimeManager* tm, const double frameTime)
 {
     tm->fpsAccumulator += frameTime;
@@ -61,6 +308,12 @@ void InitTimeManager(TimeManager* tm, const TimeManagerConfig* config)
 {
     tm->physicsHz = config->physicsHz > 0 ? config->physicsHz : DEFAULT_PHYSICS_HZ;
     tm->physicsTimeStep = 1.0 / (double)tm->physicsHz;
+    tm->tick = 0;
+    tm->baseTick = 0;
+    tm->baseSimTimeNs = 0;
+    tm->stepNumNs = (uint64_t)NANOSECONDS_PER_SECOND_LL;
+    tm->stepDen = tm->physicsHz;
+    tm->unscaledTimeNs = 0;
     tm->maxFrameTime = config->maxFrameTime > 0.0 ? config->maxFrameTime : DEFAULT_MAX_FRAME_TIME;
     tm->maxPhysicsSteps = config->maxPhysicsSteps > 0 ? config->maxPhysicsSteps : DEFAULT_MAX_PHYSICS_STEPS;
     tm->timeScale = config->timeScale > 0.0 ? config->timeScale : DEFAULT_TIME_SCALE;
@@ -73,6 +326,11 @@ void InitTimeManager(TimeManager* tm, const TimeManagerConfig* config)
     tm->fpsAccumulator = 0.0;
     tm->fpsFrameCount = 0;
     tm->timeScaleBeforePause = DEFAULT_TIME_SCALE;
+    tm->renderMode = TM_RENDER_INTERPOLATE;
+    tm->maxExtrapolationAlpha = DEFAULT_MAX_EXTRAPOLATION_ALPHA;
+    tm->substep.divisor = 1;
+    tm->substep.maxSubsteps = DEFAULT_MAX_SUBSTEPS;
+    tm->present.swapInterval = 1;
 }
 
 TimeManager* TmCreate(const TimeManagerConfig* config)
@@ -112,46 +370,77 @@ FrameTimingData TmBeginFrame(TimeManager* tm)
     {
         tm->firstFrame = false;
         tm->lastTime = tm->now();
+        RecordFrameAnchor(tm);
         return (FrameTimingData){
             .physicsSteps = 0,
             .fixedTimestep = tm->physicsTimeStep,
-            .interpolationAlpha = 0.0,
+            .interpolationAlpha = RenderAlpha(tm, 0.0),
             .frameTime = 0.0,
             .lagging = false,
             .rawFrameTime = 0.0,
             .unscaledFrameTime = 0.0,
-            .currentTimeScale = tm->timeScale
+            .currentTimeScale = tm->timeScale,
+            .droppedTime = 0.0,
+            .extrapolationTime = 0.0,
+            .tick = tm->tick,
+            .simTimeNs = SimTimeAtTick(tm, tm->tick),
+            .unscaledTimeNs = tm->unscaledTimeNs
         };
     }
     assert(tm->physicsTimeStep > 0.0 && "physicsTimeStep must be > 0");
 
     const HighResTimeT currentTime = tm->now();
-    const double deltaTime = fmax((double)(currentTime.nanoseconds - tm->lastTime.nanoseconds) / NANOSECONDS_PER_SECOND,
-                                  DBL_EPSILON);
+    const long long frameBeginNs = tm->lastTime.nanoseconds;
+    const long long deltaNs = currentTime.nanoseconds - frameBeginNs;
+    const double deltaTime = fmax((double)deltaNs / NANOSECONDS_PER_SECOND, DBL_EPSILON);
     const double cappedDeltaTime = fmin(deltaTime, tm->maxFrameTime);
     const double scaledFrameTime = cappedDeltaTime * tm->timeScale;
     tm->lastTime = currentTime;
     tm->accumulator += scaledFrameTime;
 
-    const double stepsD = floor((tm->accumulator + FLOATING_POINT_EPSILON) / tm->physicsTimeStep);
-    const bool lagging = stepsD > (double)tm->maxPhysicsSteps;
-    const size_t steps = lagging ? tm->maxPhysicsSteps : (size_t)stepsD;
-    tm->physicsStepsThisFrame = steps;
+    const double accumulatedTime = tm->accumulator;
+    bool lagging = false;
+    tm->physicsStepsThisFrame = ConsumeAccumulator(tm, tm->maxPhysicsSteps, &lagging);
 
-    double remainder = fmod(tm->accumulator, tm->physicsTimeStep);
-    if (remainder < 0.0)
+    const uint64_t firstTick = tm->tick;
+    tm->tick += tm->physicsStepsThisFrame;
+    TM_PROBE3(steps_computed, firstTick, tm->physicsStepsThisFrame, TM_PROBE_NS(tm->accumulator));
+
+    // Time thrown away by the step clamp was never fed into the simulation, same as time past the cap
+    double clampedTime = 0.0;
+    if (lagging && tm->timeScale > 0.0)
     {
-        remainder += tm->physicsTimeStep;
+        const double steppedTime = (double)tm->physicsStepsThisFrame * tm->physicsTimeStep;
+        clampedTime = fmax(accumulatedTime - steppedTime - tm->accumulator, 0.0) / tm->timeScale;
+    }
+    const double droppedTime = deltaTime - cappedDeltaTime + clampedTime;
+    const int64_t fedNs = deltaTime > tm->maxFrameTime ? llround(tm->maxFrameTime * NANOSECONDS_PER_SECOND)
+                          : deltaNs > 0                ? deltaNs
+                                                       : 0;
+    tm->unscaledTimeNs += fedNs - llround(clampedTime * NANOSECONDS_PER_SECOND);
+    if (lagging)
+    {
+        TM_PROBE3(lag_detected, firstTick, tm->physicsStepsThisFrame, TM_PROBE_NS(droppedTime));
     }
-
-    tm->accumulator = remainder;
 
     // Calculate interpolation alpha
-    const double alpha = Clamp(tm->accumulator / tm->physicsTimeStep, 0.0, 1.0);
+    const double alpha = RenderAlpha(tm, tm->accumulator);
+
+    tm->substep.stepsThisFrame = 0;
+    tm->substep.substepsThisFrame = 0;
+    tm->substep.maxThisFrame = 0;
+    RecordFrameAnchor(tm);
 
+    #if TM_STATS_LEVEL >= TM_STATS_BASIC
     UpdateFpsStats(tm, deltaTime);
+    const uint32_t phaseBudgetExceeded = EndFramePhases(tm, currentTime.nanoseconds);
+    #else
+    const uint32_t phaseBudgetExceeded = 0;
+    #endif
+    TM_PROBE5(frame_begin, firstTick, TM_PROBE_NS(deltaTime), TM_PROBE_NS(scaledFrameTime), tm->physicsStepsThisFrame,
+              lagging);
 
-    return (FrameTimingData){
+    const FrameTimingData result = {
         .physicsSteps = tm->physicsStepsThisFrame,
         .fixedTimestep = tm->physicsTimeStep,
         .interpolationAlpha = alpha,
@@ -159,10 +448,183 @@ FrameTimingData TmBeginFrame(TimeManager* tm)
         .lagging = lagging,
         .rawFrameTime = deltaTime,
         .unscaledFrameTime = cappedDeltaTime,
-        .currentTimeScale = tm->timeScale
+        .currentTimeScale = tm->timeScale,
+        .droppedTime = droppedTime,
+        .extrapolationTime = ExtrapolationTime(tm, alpha),
+        .tick = firstTick,
+        .simTimeNs = SimTimeAtTick(tm, tm->tick),
+        .unscaledTimeNs = tm->unscaledTimeNs,
+        .phaseBudgetExceeded = phaseBudgetExceeded,
+        .presentInterval = tm->present.stats.lastInterval,
+        .presentRefreshes = tm->present.lastRefreshes
+    };
+    #if TM_STATS_LEVEL >= TM_STATS_TRACING
+    if (tm->perfCounters)
+    {
+        TmPerfCountersSample(tm->perfCounters);
+    }
+    if (tm->threadUsage)
+    {
+        TmThreadUsageSample(tm->threadUsage, deltaTime);
+    }
+    if (tm->flightRecorder)
+    {
+        TmFlightRecorderRecord(tm->flightRecorder, tm, &result);
+    }
+    if (tm->lagAttribution)
+    {
+        TmLagAttributionRecord(tm->lagAttribution, &result);
+    }
+    if (tm->traceExporter)
+    {
+        TmTraceExporterRecordFrame(tm->traceExporter, frameBeginNs, currentTime.nanoseconds, &result);
+    }
+    #endif
+    return result;
+}
+
+void TmAttachFlightRecorder(TimeManager* tm, TmFlightRecorder* recorder)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->flightRecorder = recorder;
+}
+
+void TmAttachTraceExporter(TimeManager* tm, TmTraceExporter* exporter)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->traceExporter = exporter;
+}
+
+void TmAttachPerfCounters(TimeManager* tm, TmPerfCounters* counters)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->perfCounters = counters;
+}
+
+TmPerfCounters* TmGetPerfCounters(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->perfCounters;
+}
+
+void TmAttachThreadUsage(TimeManager* tm, TmThreadUsage* usage)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->threadUsage = usage;
+    if (usage)
+    {
+        TmThreadUsageRestart(usage);
+    }
+}
+
+TmThreadUsage* TmGetThreadUsage(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->threadUsage;
+}
+
+void TmAttachLagAttribution(TimeManager* tm, TmLagAttribution* attribution)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->lagAttribution = attribution;
+}
+
+FrameTimingData TmAdvanceSteps(TimeManager* tm, const size_t steps)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(tm->physicsTimeStep > 0.0 && "physicsTimeStep must be > 0");
+
+    tm->physicsStepsThisFrame = steps;
+    const uint64_t firstTick = tm->tick;
+    tm->tick += steps;
+    ReanchorFrameHistory(tm);
+    const double alpha = RenderAlpha(tm, tm->accumulator);
+
+    return (FrameTimingData){
+        .physicsSteps = steps,
+        .fixedTimestep = tm->physicsTimeStep,
+        .interpolationAlpha = alpha,
+        .frameTime = (double)steps * tm->physicsTimeStep,
+        .lagging = false,
+        .rawFrameTime = 0.0,
+        .unscaledFrameTime = 0.0,
+        .currentTimeScale = tm->timeScale,
+        .droppedTime = 0.0,
+        .extrapolationTime = ExtrapolationTime(tm, alpha),
+        .tick = firstTick,
+        .simTimeNs = SimTimeAtTick(tm, tm->tick),
+        .unscaledTimeNs = tm->unscaledTimeNs
+    };
+}
+
+FrameTimingData TmAdvanceSimTime(TimeManager* tm, const double simTime)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(tm->physicsTimeStep > 0.0 && "physicsTimeStep must be > 0");
+    assert(simTime >= 0.0 && "simTime must not be negative!");
+
+    const double advance = fmax(simTime, 0.0);
+    tm->accumulator += advance;
+
+    bool lagging = false;
+    tm->physicsStepsThisFrame = ConsumeAccumulator(tm, SIZE_MAX, &lagging);
+    const uint64_t firstTick = tm->tick;
+    tm->tick += tm->physicsStepsThisFrame;
+    ReanchorFrameHistory(tm);
+    const double alpha = RenderAlpha(tm, tm->accumulator);
+
+    return (FrameTimingData){
+        .physicsSteps = tm->physicsStepsThisFrame,
+        .fixedTimestep = tm->physicsTimeStep,
+        .interpolationAlpha = alpha,
+        .frameTime = advance,
+        .lagging = false,
+        .rawFrameTime = 0.0,
+        .unscaledFrameTime = 0.0,
+        .currentTimeScale = tm->timeScale,
+        .droppedTime = 0.0,
+        .extrapolationTime = ExtrapolationTime(tm, alpha),
+        .tick = firstTick,
+        .simTimeNs = SimTimeAtTick(tm, tm->tick),
+        .unscaledTimeNs = tm->unscaledTimeNs
     };
 }
 
+size_t TmComputeCatchUpSteps(const TimeManager* tm, const double elapsed)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(tm->physicsTimeStep > 0.0 && "physicsTimeStep must be > 0");
+
+    const double accumulated = tm->accumulator + fmax(elapsed, 0.0) * tm->timeScale;
+    return (size_t)WholeUnits(accumulated, tm->physicsTimeStep);
+}
+
+size_t TmFastForward(TimeManager* tm, const double elapsed, const size_t chunkSize, const TmStepBatchFn stepFn,
+                     void* userData)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(stepFn != NULL && "stepFn pointer is null!");
+    assert(tm->physicsTimeStep > 0.0 && "physicsTimeStep must be > 0");
+
+    tm->accumulator += fmax(elapsed, 0.0) * tm->timeScale;
+    tm->unscaledTimeNs += llround(fmax(elapsed, 0.0) * NANOSECONDS_PER_SECOND);
+
+    bool lagging = false;
+    const size_t steps = ConsumeAccumulator(tm, SIZE_MAX, &lagging);
+    const size_t chunk = chunkSize > 0 ? chunkSize : DEFAULT_FAST_FORWARD_CHUNK;
+
+    for (size_t remaining = steps; remaining > 0;)
+    {
+        const size_t batch = remaining < chunk ? remaining : chunk;
+        stepFn(userData, tm->tick, batch, tm->physicsTimeStep);
+        tm->tick += batch;
+        remaining -= batch;
+    }
+    ReanchorFrameHistory(tm);
+
+    return steps;
+}
+
 void TmSetPhysicsHz(TimeManager* tm, const size_t physicsHz)
 {
     assert(tm != NULL && "TimeManager pointer is null!");
@@ -173,6 +635,7 @@ void TmSetPhysicsHz(TimeManager* tm, const size_t physicsHz)
 
     tm->physicsHz = physicsHz;
     tm->physicsTimeStep = 1.0 / (double)physicsHz;
+    RebaseSimClock(tm, (uint64_t)NANOSECONDS_PER_SECOND_LL, physicsHz);
 }
 
 void TmSetPhysicsTimeStep(TimeManager* tm, const double physicsTimeStep)
@@ -184,6 +647,7 @@ void TmSetPhysicsTimeStep(TimeManager* tm, const double physicsTimeStep)
     }
 
     tm->physicsTimeStep = physicsTimeStep;
+    RebaseSimClock(tm, (uint64_t)llround(physicsTimeStep * NANOSECONDS_PER_SECOND), 1);
 
     const double hzD = 1.0 / physicsTimeStep;
     size_t hz = (size_t)llround(hzD);
@@ -211,6 +675,7 @@ void TmSetTimeScale(TimeManager* tm, const double timeScale)
 {
     assert(tm != NULL && "TimeManager pointer is null!");
     tm->timeScale = (timeScale < 0.0) ? 0.0 : timeScale;
+    TimeScaleChanged(tm);
 }
 
 double TmGetAccumulator(const TimeManager* tm)
@@ -231,6 +696,7 @@ void TmSetTimeSource(TimeManager* tm, HighResTimeT (*nowFn)(void))
     assert(nowFn != NULL && "nowFn pointer is null!");
     tm->now = nowFn;
     tm->lastTime = tm->now();
+    tm->frameHistory.count = 0;
 }
 
 double TmGetPhysicsTimeStep(const TimeManager* tm)
@@ -279,7 +745,24 @@ void TmReset(TimeManager* tm)
     tm->fpsAccumulator = 0.0;
     tm->fpsFrameCount = 0;
     tm->timeScale = 1.0;
+    TimeScaleChanged(tm);
     tm->averageFps = 0.0;
+    tm->tick = 0;
+    tm->baseTick = 0;
+    tm->baseSimTimeNs = 0;
+    tm->unscaledTimeNs = 0;
+    tm->frameHistory.count = 0;
+
+    // Phase budgets and the refresh period are configuration and survive the reset
+    memset(tm->phases.frameNs, 0, sizeof tm->phases.frameNs);
+    memset(tm->phases.last, 0, sizeof tm->phases.last);
+    memset(tm->phases.overBudget, 0, sizeof tm->phases.overBudget);
+    tm->phases.windowNext = 0;
+    tm->phases.windowCount = 0;
+    tm->phases.open = 0;
+    tm->present.lastNs = 0;
+    tm->present.lastRefreshes = 0;
+    memset(&tm->present.stats, 0, sizeof tm->present.stats);
 }
 
 void TmPause(TimeManager* tm)
@@ -287,12 +770,14 @@ void TmPause(TimeManager* tm)
     assert(tm != NULL && "TimeManager pointer is null!");
     tm->timeScaleBeforePause = tm->timeScale;
     tm->timeScale = 0.0;
+    TimeScaleChanged(tm);
 }
 
 void TmResume(TimeManager* tm)
 {
     assert(tm != NULL && "TimeManager pointer is null!");
     tm->timeScale = tm->timeScaleBeforePause > 0.0 ? tm->timeScaleBeforePause : 1.0;
+    TimeScaleChanged(tm);
 }
 
 bool TmIsPaused(const TimeManager* tm)
@@ -300,3 +785,564 @@ bool TmIsPaused(const TimeManager* tm)
     assert(tm != NULL && "TimeManager pointer is null!");
     return fabs(tm->timeScale) <= DBL_EPSILON;
 }
+
+HighResTimeT TmNow(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->now();
+}
+
+HighResTimeT TmGetFrameStartTime(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->lastTime;
+}
+
+TmLatchedTiming TmLatchTiming(const TimeManager* tm, const HighResTimeT timestamp)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(tm->physicsTimeStep > 0.0 && "physicsTimeStep must be > 0");
+
+    const double sinceFrame =
+        fmax((double)(timestamp.nanoseconds - tm->lastTime.nanoseconds) / NANOSECONDS_PER_SECOND, 0.0);
+    const double accumulator = tm->accumulator + fmin(sinceFrame, tm->maxFrameTime) * tm->timeScale;
+    const double alpha = RenderAlpha(tm, accumulator);
+
+    return (TmLatchedTiming){
+        .interpolationAlpha = alpha,
+        .extrapolationTime = ExtrapolationTime(tm, alpha),
+        .simTimeSinceStep = accumulator,
+        .timeSinceFrame = sinceFrame,
+        .simTimeNs = SimTimeAtTick(tm, tm->tick) + llround(accumulator * NANOSECONDS_PER_SECOND)
+    };
+}
+
+TmTickPosition TmMapTimestampToTick(const TimeManager* tm, const HighResTimeT timestamp)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+
+    const size_t count = tm->frameHistory.count;
+    if (count == 0)
+    {
+        return TmGetTickAtSimTime(tm, CurrentSimTimeNs(tm));
+    }
+
+    // Find the latest frame that started at or before the timestamp, walking back from the newest
+    const int64_t t = timestamp.nanoseconds;
+    size_t age = 0;
+    size_t slot = (tm->frameHistory.next + FRAME_HISTORY_SIZE - 1) % FRAME_HISTORY_SIZE;
+    while (age + 1 < count && tm->frameHistory.wallNs[slot] > t)
+    {
+        slot = (slot + FRAME_HISTORY_SIZE - 1) % FRAME_HISTORY_SIZE;
+        age++;
+    }
+
+    const int64_t wallNs = tm->frameHistory.wallNs[slot];
+    const int64_t simNs = tm->frameHistory.simNs[slot];
+    if (t <= wallNs)
+    {
+        // Older than the history: the earliest anchor is the best estimate
+        return TmGetTickAtSimTime(tm, simNs);
+    }
+
+    const double elapsed = fmin((double)(t - wallNs) / NANOSECONDS_PER_SECOND, tm->maxFrameTime);
+    if (age == 0)
+    {
+        // After the latest frame: sim time runs on at the current timescale, as TmLatchTiming projects it
+        return TmGetTickAtSimTime(tm, simNs + llround(elapsed * tm->timeScale * NANOSECONDS_PER_SECOND));
+    }
+
+    // Between two frames: the sim advanced by exactly the difference of their anchors over the capped wall
+    // time, so use that rate and never pass the next anchor when time was dropped
+    const size_t nextSlot = (slot + 1) % FRAME_HISTORY_SIZE;
+    const int64_t nextSimNs = tm->frameHistory.simNs[nextSlot];
+    const double span = fmin((double)(tm->frameHistory.wallNs[nextSlot] - wallNs) / NANOSECONDS_PER_SECOND,
+                             tm->maxFrameTime);
+    const double rate = span > 0.0 ? (double)(nextSimNs - simNs) / NANOSECONDS_PER_SECOND / span : 0.0;
+    const int64_t mapped = simNs + llround(elapsed * rate * NANOSECONDS_PER_SECOND);
+    return TmGetTickAtSimTime(tm, mapped < nextSimNs ? mapped : nextSimNs);
+}
+
+void TmSaveTimingState(const TimeManager* tm, TmTimingState* state)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(state != NULL && "state pointer is null!");
+    state->accumulator = tm->accumulator;
+    state->physicsTimeStep = tm->physicsTimeStep;
+    state->timeScale = tm->timeScale;
+    state->timeScaleBeforePause = tm->timeScaleBeforePause;
+    state->physicsHz = tm->physicsHz;
+    state->tick = tm->tick;
+    state->simTimeNs = SimTimeAtTick(tm, tm->tick);
+    state->stepNumNs = tm->stepNumNs;
+    state->stepDen = tm->stepDen;
+    state->unscaledTimeNs = tm->unscaledTimeNs;
+}
+
+void TmRestoreTimingState(TimeManager* tm, const TmTimingState* state)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(state != NULL && "state pointer is null!");
+    assert(state->physicsTimeStep > 0.0 && "physicsTimeStep must be > 0");
+    tm->accumulator = state->accumulator;
+    tm->physicsTimeStep = state->physicsTimeStep;
+    tm->timeScale = state->timeScale;
+    tm->timeScaleBeforePause = state->timeScaleBeforePause;
+    tm->physicsHz = (size_t)state->physicsHz;
+    tm->tick = state->tick;
+    tm->baseTick = state->tick;
+    tm->baseSimTimeNs = state->simTimeNs;
+    tm->stepNumNs = state->stepNumNs > 0 ? state->stepNumNs : 1;
+    tm->stepDen = state->stepDen > 0 ? state->stepDen : 1;
+    tm->unscaledTimeNs = state->unscaledTimeNs;
+
+    // The recorded anchors describe a timeline that was rolled back
+    const bool anchored = tm->frameHistory.count > 0;
+    tm->frameHistory.count = 0;
+    if (anchored)
+    {
+        RecordFrameAnchor(tm);
+    }
+}
+
+size_t TmSerializeTimingState(const TmTimingState* state, void* buffer, const size_t bufferSize)
+{
+    assert(state != NULL && "state pointer is null!");
+    if (buffer == NULL || bufferSize < TM_TIMING_STATE_SERIALIZED_SIZE)
+    {
+        return 0;
+    }
+
+    unsigned char* p = buffer;
+    p = PutU32(p, TIMING_STATE_MAGIC);
+    p = PutU16(p, TIMING_STATE_VERSION);
+    p = PutU16(p, 0);
+    p = PutF64(p, state->accumulator);
+    p = PutF64(p, state->physicsTimeStep);
+    p = PutF64(p, state->timeScale);
+    p = PutF64(p, state->timeScaleBeforePause);
+    p = PutU64(p, state->physicsHz);
+    p = PutU64(p, state->tick);
+    p = PutU64(p, (uint64_t)state->simTimeNs);
+    p = PutU64(p, state->stepNumNs);
+    p = PutU64(p, state->stepDen);
+    p = PutU64(p, (uint64_t)state->unscaledTimeNs);
+
+    return (size_t)(p - (unsigned char*)buffer);
+}
+
+bool TmDeserializeTimingState(TmTimingState* state, const void* buffer, const size_t bufferSize)
+{
+    assert(state != NULL && "state pointer is null!");
+    if (buffer == NULL || bufferSize < TM_TIMING_STATE_SERIALIZED_SIZE)
+    {
+        return false;
+    }
+
+    const unsigned char* p = buffer;
+    if (GetU32(p) != TIMING_STATE_MAGIC || GetU16(p + 4) != TIMING_STATE_VERSION)
+    {
+        return false;
+    }
+
+    TmTimingState decoded;
+    decoded.accumulator = GetF64(p + 8);
+    decoded.physicsTimeStep = GetF64(p + 16);
+    decoded.timeScale = GetF64(p + 24);
+    decoded.timeScaleBeforePause = GetF64(p + 32);
+    decoded.physicsHz = GetU64(p + 40);
+    decoded.tick = GetU64(p + 48);
+    decoded.simTimeNs = (int64_t)GetU64(p + 56);
+    decoded.stepNumNs = GetU64(p + 64);
+    decoded.stepDen = GetU64(p + 72);
+    decoded.unscaledTimeNs = (int64_t)GetU64(p + 80);
+
+    // Reject anything TmRestoreTimingState could not have produced
+    if (!(decoded.physicsTimeStep > 0.0) || !(decoded.accumulator >= 0.0) || !(decoded.timeScale >= 0.0) ||
+        !(decoded.timeScaleBeforePause >= 0.0) || decoded.physicsHz == 0 || decoded.stepNumNs == 0 ||
+        decoded.stepDen == 0)
+    {
+        return false;
+    }
+
+    *state = decoded;
+    return true;
+}
+
+void TmSetRenderMode(TimeManager* tm, const TmRenderMode mode)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->renderMode = mode;
+}
+
+TmRenderMode TmGetRenderMode(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->renderMode;
+}
+
+void TmSetMaxExtrapolationAlpha(TimeManager* tm, const double maxAlpha)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->maxExtrapolationAlpha = fmax(maxAlpha, 1.0);
+}
+
+double TmGetMaxExtrapolationAlpha(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->maxExtrapolationAlpha;
+}
+
+void TmSetSubstepDivisor(TimeManager* tm, const size_t divisor)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->substep.divisor = divisor > 0 ? divisor : 1;
+    tm->substep.metricFn = NULL;
+    tm->substep.metricUserData = NULL;
+}
+
+void TmSetSubstepMetric(TimeManager* tm, const TmStiffnessFn metricFn, void* userData, const size_t maxSubsteps)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->substep.metricFn = metricFn;
+    tm->substep.metricUserData = userData;
+    tm->substep.maxSubsteps = maxSubsteps > 0 ? maxSubsteps : DEFAULT_MAX_SUBSTEPS;
+}
+
+TmSubstepInfo TmComputeSubsteps(TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+
+    size_t substeps = tm->substep.divisor;
+    if (tm->substep.metricFn)
+    {
+        const double metric = ceil(tm->substep.metricFn(tm->substep.metricUserData));
+        // NaN fails both comparisons and falls through to a single substep
+        substeps = metric >= (double)tm->substep.maxSubsteps ? tm->substep.maxSubsteps
+                   : metric > 1.0                             ? (size_t)metric
+                                                              : 1;
+    }
+
+    tm->substep.stepsThisFrame++;
+    tm->substep.substepsThisFrame += substeps;
+    if (substeps > tm->substep.maxThisFrame)
+    {
+        tm->substep.maxThisFrame = substeps;
+    }
+    tm->substep.totalSteps++;
+    tm->substep.totalSubsteps += substeps;
+
+    return (TmSubstepInfo){
+        .substeps = substeps,
+        .substepDt = tm->physicsTimeStep / (double)substeps,
+        .alphaStep = 1.0 / (double)substeps
+    };
+}
+
+TmSubstepStats TmGetSubstepStats(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return (TmSubstepStats){
+        .steps = tm->substep.stepsThisFrame,
+        .substeps = tm->substep.substepsThisFrame,
+        .maxSubsteps = tm->substep.maxThisFrame,
+        .averageSubsteps = tm->substep.totalSteps > 0
+                               ? (double)tm->substep.totalSubsteps / (double)tm->substep.totalSteps
+                               : 0.0
+    };
+}
+
+void TmPhaseBegin(TimeManager* tm, const TmFramePhase phase)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(phase >= 0 && phase < TM_PHASE_COUNT && "phase out of range!");
+    #if TM_STATS_LEVEL >= TM_STATS_BASIC
+    tm->phases.beginNs[phase] = tm->now().nanoseconds;
+    tm->phases.open |= 1u << phase;
+    #else
+    (void)tm;
+    (void)phase;
+    #endif
+}
+
+void TmPhaseEnd(TimeManager* tm, const TmFramePhase phase)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(phase >= 0 && phase < TM_PHASE_COUNT && "phase out of range!");
+    if (!(tm->phases.open & (1u << phase)))
+    {
+        return;
+    }
+    const long long nowNs = tm->now().nanoseconds;
+    tm->phases.frameNs[phase] += nowNs - tm->phases.beginNs[phase];
+    tm->phases.open &= ~(1u << phase);
+    #if TM_STATS_LEVEL >= TM_STATS_TRACING
+    if (tm->traceExporter)
+    {
+        TmTraceExporterRecordPhase(tm->traceExporter, phase, tm->phases.beginNs[phase], nowNs);
+    }
+    #endif
+}
+
+void TmSetPhaseBudget(TimeManager* tm, const TmFramePhase phase, const double budget)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(phase >= 0 && phase < TM_PHASE_COUNT && "phase out of range!");
+    tm->phases.budget[phase] = budget > 0.0 ? budget : 0.0;
+}
+
+TmPhaseStats TmGetPhaseStats(const TimeManager* tm, const TmFramePhase phase)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(phase >= 0 && phase < TM_PHASE_COUNT && "phase out of range!");
+
+    double sum = 0.0;
+    double max = 0.0;
+    for (size_t i = 0; i < tm->phases.windowCount; ++i)
+    {
+        sum += tm->phases.window[phase][i];
+        max = fmax(max, tm->phases.window[phase][i]);
+    }
+
+    return (TmPhaseStats){
+        .last = tm->phases.last[phase],
+        .average = tm->phases.windowCount > 0 ? sum / (double)tm->phases.windowCount : 0.0,
+        .max = max,
+        .budget = tm->phases.budget[phase],
+        .overBudgetFrames = tm->phases.overBudget[phase]
+    };
+}
+
+void TmMarkPresent(TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    TmMarkPresentAt(tm, tm->now());
+}
+
+void TmMarkPresentAt(TimeManager* tm, const HighResTimeT timestamp)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    TmPresentStats* stats = &tm->present.stats;
+    if (stats->presents > 0 && timestamp.nanoseconds <= tm->present.lastNs)
+    {
+        return;
+    }
+
+    const bool first = stats->presents == 0;
+    const double interval = first ? 0.0 : (double)(timestamp.nanoseconds - tm->present.lastNs) / NANOSECONDS_PER_SECOND;
+    tm->present.lastNs = timestamp.nanoseconds;
+    stats->presents++;
+    if (first)
+    {
+        return;
+    }
+
+    stats->averageInterval = stats->presents == 2 ? interval
+                                                  : stats->averageInterval
+                                                        + (interval - stats->averageInterval) * PRESENT_SMOOTHING;
+    stats->lastInterval = interval;
+    stats->maxInterval = fmax(stats->maxInterval, interval);
+
+    tm->present.lastRefreshes = 0;
+    if (tm->present.refreshPeriod > 0.0)
+    {
+        const size_t refreshes = (size_t)llround(interval / tm->present.refreshPeriod);
+        tm->present.lastRefreshes = refreshes;
+        if (refreshes == 0)
+        {
+            stats->earlyPresents++;
+        }
+        else if (refreshes > tm->present.swapInterval)
+        {
+            stats->repeatedRefreshes += refreshes - tm->present.swapInterval;
+        }
+    }
+}
+
+void TmSetRefreshPeriod(TimeManager* tm, const double refreshPeriod, const size_t swapInterval)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    tm->present.refreshPeriod = refreshPeriod > 0.0 ? refreshPeriod : 0.0;
+    tm->present.swapInterval = swapInterval > 0 ? swapInterval : 1;
+}
+
+TmPresentStats TmGetPresentStats(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->present.stats;
+}
+
+uint64_t TmGetTick(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->tick;
+}
+
+int64_t TmGetSimTimeNs(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return SimTimeAtTick(tm, tm->tick);
+}
+
+int64_t TmGetSimTimeAtTick(const TimeManager* tm, const uint64_t tick)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return SimTimeAtTick(tm, tick);
+}
+
+TmTickPosition TmGetTickAtSimTime(const TimeManager* tm, const int64_t simTimeNs)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+
+    // Floor division of the offset from the clock base into ticks, split like TickSpanNs
+    const int64_t num = (int64_t)tm->stepNumNs;
+    const int64_t den = (int64_t)tm->stepDen;
+    const int64_t offset = simTimeNs - tm->baseSimTimeNs;
+    int64_t q = offset / num;
+    int64_t r = offset % num;
+    if (r < 0)
+    {
+        q--;
+        r += num;
+    }
+    const int64_t relative = q * den + (r * den) / num;
+    if (relative < 0 && (uint64_t)(-relative) > tm->baseTick)
+    {
+        return (TmTickPosition){.tick = 0, .fraction = 0.0};
+    }
+
+    // SimTimeAtTick floors each tick's time, so the estimate can be one tick off at boundaries
+    uint64_t tick = relative < 0 ? tm->baseTick - (uint64_t)(-relative) : tm->baseTick + (uint64_t)relative;
+    while (tick > 0 && SimTimeAtTick(tm, tick) > simTimeNs)
+    {
+        tick--;
+    }
+    while (SimTimeAtTick(tm, tick + 1) <= simTimeNs)
+    {
+        tick++;
+    }
+
+    const int64_t start = SimTimeAtTick(tm, tick);
+    const int64_t span = SimTimeAtTick(tm, tick + 1) - start;
+    const double fraction = simTimeNs > start && span > 0 ? (double)(simTimeNs - start) / (double)span : 0.0;
+    return (TmTickPosition){.tick = tick, .fraction = fraction};
+}
+
+int64_t TmGetUnscaledTimeNs(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->unscaledTimeNs;
+}
+
+void TmSetRunAhead(TimeManager* tm, const size_t steps, const TmRunAheadCallbacks* callbacks)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(!tm->runAhead.active && "Cannot reconfigure run-ahead while speculating!");
+    assert((steps == 0 || (callbacks != NULL && callbacks->save != NULL && callbacks->restore != NULL &&
+                           callbacks->step != NULL)) &&
+           "Run-ahead needs save, restore and step callbacks!");
+
+    tm->runAhead.steps = steps;
+    if (callbacks)
+    {
+        tm->runAhead.callbacks = *callbacks;
+    }
+}
+
+size_t TmBeginRunAhead(TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(!tm->runAhead.active && "TmBeginRunAhead called twice without TmEndRunAhead!");
+    if (tm->runAhead.steps == 0)
+    {
+        return 0;
+    }
+
+    const TmRunAheadCallbacks* cb = &tm->runAhead.callbacks;
+    const HighResTimeT start = GetHighResolutionTime();
+    cb->save(cb->userData);
+    const HighResTimeT saved = GetHighResolutionTime();
+
+    // Speculate on the ticks the real simulation runs next, leaving tick and accumulator alone
+    for (size_t i = 0; i < tm->runAhead.steps; ++i)
+    {
+        cb->step(cb->userData, tm->tick + i, tm->physicsTimeStep);
+    }
+    const HighResTimeT stepped = GetHighResolutionTime();
+
+    tm->runAhead.active = true;
+    tm->runAhead.stats.steps = tm->runAhead.steps;
+    tm->runAhead.stats.saveTime = SecondsBetween(start, saved);
+    tm->runAhead.stats.stepTime = SecondsBetween(saved, stepped);
+    return tm->runAhead.steps;
+}
+
+void TmEndRunAhead(TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    if (!tm->runAhead.active)
+    {
+        return;
+    }
+
+    const TmRunAheadCallbacks* cb = &tm->runAhead.callbacks;
+    const HighResTimeT start = GetHighResolutionTime();
+    cb->restore(cb->userData);
+    const HighResTimeT restored = GetHighResolutionTime();
+    tm->runAhead.active = false;
+
+    TmRunAheadStats* stats = &tm->runAhead.stats;
+    stats->restoreTime = SecondsBetween(start, restored);
+
+    // Rendering between begin and end is not speculation cost
+    const double total = stats->saveTime + stats->stepTime + stats->restoreTime;
+    tm->runAhead.totalTime += total;
+    tm->runAhead.frames++;
+    stats->averageTime = tm->runAhead.totalTime / (double)tm->runAhead.frames;
+    stats->maxTime = fmax(stats->maxTime, total);
+}
+
+TmRunAheadStats TmGetRunAheadStats(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->runAhead.stats;
+}
+
+size_t TmResimulate(TimeManager* tm, const uint64_t ackedTick, const TmStepFn stepFn, void* userData)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    assert(stepFn != NULL && "stepFn pointer is null!");
+
+    const uint64_t presentTick = tm->tick;
+    if (ackedTick >= presentTick)
+    {
+        // Nothing to replay: not a correction
+        return 0;
+    }
+
+    const double dt = tm->physicsTimeStep;
+    const HighResTimeT start = GetHighResolutionTime();
+    for (uint64_t tick = ackedTick; tick < presentTick; ++tick)
+    {
+        stepFn(userData, tick, dt);
+    }
+    const double elapsed = SecondsBetween(start, GetHighResolutionTime());
+    const size_t steps = (size_t)(presentTick - ackedTick);
+
+    TmResimulationStats* stats = &tm->resim;
+    stats->steps = steps;
+    stats->time = elapsed;
+    stats->corrections++;
+    stats->maxSteps = steps > stats->maxSteps ? steps : stats->maxSteps;
+    stats->maxTime = fmax(stats->maxTime, elapsed);
+    tm->resimTotalTime += elapsed;
+    stats->averageTime = tm->resimTotalTime / (double)stats->corrections;
+
+    return steps;
+}
+
+TmResimulationStats TmGetResimulationStats(const TimeManager* tm)
+{
+    assert(tm != NULL && "TimeManager pointer is null!");
+    return tm->resim;
+}
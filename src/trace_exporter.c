@@ -0,0 +1,322 @@
+﻿//
+// Created by blomq on 2026-10-16.
+//
+
+#include "time_manager/trace_exporter.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "atomic_compat.h"
+#include "thread_compat.h"
+
+// Keeps the producer and consumer positions on separate cache lines
+#define CACHE_LINE_SIZE 64
+
+// Track ids in the trace; frames and phases get a row each so the spans nest cleanly
+#define TRACE_FRAME_TRACK 1
+#define TRACE_PHASE_TRACK 2
+
+typedef enum
+{
+    TRACE_FRAME,
+    TRACE_PHASE,
+    TRACE_STEP,
+    TRACE_LAGGING,
+    TRACE_TIME_SCALE
+} TraceEventKind;
+
+typedef struct
+{
+    int64_t beginNs;
+    int64_t endNs;
+    uint64_t tick;
+    double timeScale;
+    uint32_t steps;
+    uint8_t kind;
+    uint8_t phase;
+    uint8_t lagging;
+} TraceEvent;
+
+static const char* const PHASE_NAMES[TM_PHASE_COUNT] = {"Input", "Simulation", "Animation", "RenderSubmit",
+                                                        "Present"};
+
+struct TmTraceExporter
+{
+    // Producer side; cachedHead spares a shared read on every push
+    TmAtomicSize tail;
+    size_t cachedHead;
+    char padTail[CACHE_LINE_SIZE - sizeof(TmAtomicSize) - sizeof(size_t)];
+
+    // Consumer side
+    TmAtomicSize head;
+    char padHead[CACHE_LINE_SIZE - sizeof(TmAtomicSize)];
+
+    TraceEvent* events;
+    size_t mask;
+    size_t recorded;
+    size_t dropped;
+    int lastLagging;
+    double lastTimeScale;
+
+    FILE* file;
+    unsigned flushInterval;
+    TmThread writer;
+    TmAtomicSize written;
+    TmAtomicSize stop;
+};
+
+static FILE* OpenForWriting(const char* path)
+{
+    FILE* file = NULL;
+#ifdef _MSC_VER
+    if (fopen_s(&file, path, "w") != 0)
+    {
+        file = NULL;
+    }
+#else
+    file = fopen(path, "w");
+#endif
+    return file;
+}
+
+// Trace timestamps are microseconds; print them exactly from nanoseconds
+static void PrintMicros(FILE* file, const int64_t ns)
+{
+    const int64_t magnitude = ns < 0 ? -ns : ns;
+    fprintf(file, "%s%lld.%03d", ns < 0 ? "-" : "", (long long)(magnitude / 1000), (int)(magnitude % 1000));
+}
+
+static void PrintSpan(FILE* file, const char* name, const int track, const TraceEvent* event)
+{
+    fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":", name, track);
+    PrintMicros(file, event->beginNs);
+    fputs(",\"dur\":", file);
+    PrintMicros(file, event->endNs > event->beginNs ? event->endNs - event->beginNs : 0);
+}
+
+static void WriteEvent(FILE* file, const TraceEvent* event)
+{
+    switch ((TraceEventKind)event->kind)
+    {
+        case TRACE_FRAME:
+            PrintSpan(file, "Frame", TRACE_FRAME_TRACK, event);
+            fprintf(file, ",\"args\":{\"tick\":%llu,\"steps\":%u,\"lagging\":%s,\"timeScale\":%g}}",
+                    (unsigned long long)event->tick, (unsigned)event->steps, event->lagging ? "true" : "false",
+                    event->timeScale);
+            break;
+        case TRACE_PHASE:
+            PrintSpan(file, PHASE_NAMES[event->phase], TRACE_PHASE_TRACK, event);
+            fputs("}", file);
+            break;
+        case TRACE_STEP:
+            PrintSpan(file, "Step", TRACE_PHASE_TRACK, event);
+            fprintf(file, ",\"args\":{\"tick\":%llu}}", (unsigned long long)event->tick);
+            break;
+        case TRACE_LAGGING:
+            fputs(",\n{\"name\":\"Lagging\",\"ph\":\"C\",\"pid\":1,\"ts\":", file);
+            PrintMicros(file, event->beginNs);
+            fprintf(file, ",\"args\":{\"lagging\":%d}}", event->lagging ? 1 : 0);
+            break;
+        case TRACE_TIME_SCALE:
+            fputs(",\n{\"name\":\"TimeScale\",\"ph\":\"C\",\"pid\":1,\"ts\":", file);
+            PrintMicros(file, event->beginNs);
+            fprintf(file, ",\"args\":{\"timeScale\":%g}}", event->timeScale);
+            break;
+    }
+}
+
+// Writes everything the producer has published so far
+static void Drain(TmTraceExporter* exporter)
+{
+    const size_t first = TmAtomicLoadRelaxed(&exporter->head);
+    const size_t tail = TmAtomicLoadAcquire(&exporter->tail);
+    if (first == tail)
+    {
+        return;
+    }
+    for (size_t head = first; head != tail; ++head)
+    {
+        WriteEvent(exporter->file, &exporter->events[head & exporter->mask]);
+        TmAtomicStoreRelease(&exporter->head, head + 1);
+    }
+    fflush(exporter->file);
+    TmAtomicStoreRelease(&exporter->written, TmAtomicLoadRelaxed(&exporter->written) + (tail - first));
+}
+
+static TM_THREAD_PROC(WriterMain, arg)
+{
+    TmTraceExporter* exporter = arg;
+    for (;;)
+    {
+        const bool stopping = TmAtomicLoadAcquire(&exporter->stop) != 0;
+        Drain(exporter);
+        if (stopping)
+        {
+            break;
+        }
+        TmSleepMs(exporter->flushInterval);
+    }
+    return TM_THREAD_EXIT;
+}
+
+static void WriteTrackName(FILE* file, const int track, const char* name)
+{
+    fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", track,
+            name);
+}
+
+static bool Push(TmTraceExporter* exporter, const TraceEvent* event)
+{
+    exporter->recorded++;
+    const size_t tail = TmAtomicLoadRelaxed(&exporter->tail);
+    if (tail - exporter->cachedHead > exporter->mask)
+    {
+        exporter->cachedHead = TmAtomicLoadAcquire(&exporter->head);
+        if (tail - exporter->cachedHead > exporter->mask)
+        {
+            exporter->dropped++;
+            return false;
+        }
+    }
+    exporter->events[tail & exporter->mask] = *event;
+    TmAtomicStoreRelease(&exporter->tail, tail + 1);
+    return true;
+}
+
+TmTraceExporter* TmTraceExporterCreate(const TmTraceExporterConfig* config)
+{
+    assert(config != NULL && "config pointer is null!");
+    assert(config->path != NULL && "path pointer is null!");
+    if (config->capacity == 0 || config->capacity > SIZE_MAX / 2 / sizeof(TraceEvent))
+    {
+        return NULL;
+    }
+    size_t capacity = 1;
+    while (capacity < config->capacity)
+    {
+        capacity <<= 1;
+    }
+
+    TmTraceExporter* exporter = calloc(1, sizeof *exporter);
+    if (!exporter)
+    {
+        return NULL;
+    }
+    exporter->events = malloc(capacity * sizeof *exporter->events);
+    exporter->file = OpenForWriting(config->path);
+    if (!exporter->events || !exporter->file)
+    {
+        if (exporter->file)
+        {
+            fclose(exporter->file);
+        }
+        free(exporter->events);
+        free(exporter);
+        return NULL;
+    }
+    exporter->mask = capacity - 1;
+    exporter->flushInterval = config->flushInterval;
+    exporter->lastLagging = -1;
+    exporter->lastTimeScale = NAN;
+
+    fputs("[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"time_manager\"}}", exporter->file);
+    WriteTrackName(exporter->file, TRACE_FRAME_TRACK, "Frames");
+    WriteTrackName(exporter->file, TRACE_PHASE_TRACK, "Phases");
+
+    if (!TmThreadStart(&exporter->writer, WriterMain, exporter))
+    {
+        fclose(exporter->file);
+        free(exporter->events);
+        free(exporter);
+        return NULL;
+    }
+    return exporter;
+}
+
+void TmTraceExporterDestroy(TmTraceExporter* exporter)
+{
+    if (exporter == NULL)
+    {
+        return;
+    }
+    TmAtomicStoreRelease(&exporter->stop, 1);
+    TmThreadJoin(exporter->writer);
+    fputs("\n]\n", exporter->file);
+    fclose(exporter->file);
+    free(exporter->events);
+    free(exporter);
+}
+
+void TmTraceExporterRecordFrame(TmTraceExporter* exporter, const int64_t beginNs, const int64_t endNs,
+                                const FrameTimingData* frame)
+{
+    assert(exporter != NULL && "TmTraceExporter pointer is null!");
+    assert(frame != NULL && "frame pointer is null!");
+
+    const TraceEvent event = {
+        .beginNs = beginNs,
+        .endNs = endNs,
+        .tick = frame->tick,
+        .timeScale = frame->currentTimeScale,
+        .steps = (uint32_t)frame->physicsSteps,
+        .kind = TRACE_FRAME,
+        .lagging = frame->lagging
+    };
+    Push(exporter, &event);
+
+    const int lagging = frame->lagging ? 1 : 0;
+    if (lagging != exporter->lastLagging)
+    {
+        const TraceEvent counter = {.beginNs = endNs, .kind = TRACE_LAGGING, .lagging = (uint8_t)lagging};
+        if (Push(exporter, &counter))
+        {
+            exporter->lastLagging = lagging;
+        }
+    }
+    TmTraceExporterRecordTimeScale(exporter, beginNs, frame->currentTimeScale);
+}
+
+void TmTraceExporterRecordPhase(TmTraceExporter* exporter, const TmFramePhase phase, const int64_t beginNs,
+                                const int64_t endNs)
+{
+    assert(exporter != NULL && "TmTraceExporter pointer is null!");
+    assert(phase >= 0 && phase < TM_PHASE_COUNT && "phase out of range!");
+    const TraceEvent event = {.beginNs = beginNs, .endNs = endNs, .kind = TRACE_PHASE, .phase = (uint8_t)phase};
+    Push(exporter, &event);
+}
+
+void TmTraceExporterRecordStep(TmTraceExporter* exporter, const uint64_t tick, const int64_t beginNs,
+                               const int64_t endNs)
+{
+    assert(exporter != NULL && "TmTraceExporter pointer is null!");
+    const TraceEvent event = {.beginNs = beginNs, .endNs = endNs, .tick = tick, .kind = TRACE_STEP};
+    Push(exporter, &event);
+}
+
+void TmTraceExporterRecordTimeScale(TmTraceExporter* exporter, const int64_t timeNs, const double timeScale)
+{
+    assert(exporter != NULL && "TmTraceExporter pointer is null!");
+    if (timeScale == exporter->lastTimeScale)
+    {
+        return;
+    }
+    const TraceEvent event = {.beginNs = timeNs, .timeScale = timeScale, .kind = TRACE_TIME_SCALE};
+    if (Push(exporter, &event))
+    {
+        exporter->lastTimeScale = timeScale;
+    }
+}
+
+TmTraceStats TmTraceExporterGetStats(const TmTraceExporter* exporter)
+{
+    assert(exporter != NULL && "TmTraceExporter pointer is null!");
+    return (TmTraceStats){
+        .recorded = exporter->recorded,
+        .dropped = exporter->dropped,
+        .written = TmAtomicLoadAcquire((TmAtomicSize*)&exporter->written)
+    };
+}
@@ -0,0 +1,384 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "time_manager/flight_recorder.h"
+#include "test_helpers.h"
+
+static FrameTimingData make_frame(const double raw, const bool lagging)
+{
+    FrameTimingData frame;
+    memset(&frame, 0, sizeof frame);
+    frame.rawFrameTime = raw;
+    frame.frameTime = raw;
+    frame.physicsSteps = 1;
+    frame.lagging = lagging;
+    return frame;
+}
+
+static uint64_t read_u64(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i)
+    {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static uint32_t read_u32(const unsigned char* p)
+{
+    return (uint32_t)read_u64((const unsigned char[8]){p[0], p[1], p[2], p[3], 0, 0, 0, 0});
+}
+
+static size_t g_triggers = 0;
+static TmHitchKind g_trigger_kind = TM_HITCH_NONE;
+
+static void on_trigger(void* userData, TmFlightRecorder* recorder, const TmHitchKind kind)
+{
+    (void)userData;
+    (void)recorder;
+    g_triggers++;
+    g_trigger_kind = kind;
+}
+
+static int test_single_hitch_freezes(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmFlightRecorderConfig cfg = TmFlightRecorderDefaultConfig();
+    cfg.capacity = 64;
+    cfg.postTriggerFrames = 10;
+    cfg.onTrigger = on_trigger;
+    TmFlightRecorder* rec = TmFlightRecorderCreate(&cfg);
+    ASSERT_TRUE(tm != NULL && rec != NULL);
+    g_triggers = 0;
+
+    for (int i = 0; i < 40; ++i)
+    {
+        const FrameTimingData frame = make_frame(0.016, false);
+        ASSERT_TRUE(TmFlightRecorderRecord(rec, tm, &frame) == TM_HITCH_NONE);
+    }
+    ASSERT_NEAR(TmFlightRecorderGetStats(rec).baselineFrameTime, 0.016, 1e-9);
+
+    // A small rise is not a hitch
+    const FrameTimingData small = make_frame(0.0165, false);
+    ASSERT_TRUE(TmFlightRecorderRecord(rec, tm, &small) == TM_HITCH_NONE);
+
+    const FrameTimingData spike = make_frame(0.050, false);
+    ASSERT_TRUE(TmFlightRecorderRecord(rec, tm, &spike) == TM_HITCH_SINGLE);
+    ASSERT_EQ_SIZE(TmFlightRecorderGetStats(rec).singleHitches, 1);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(!TmFlightRecorderIsFrozen(rec));
+        const FrameTimingData frame = make_frame(0.016, false);
+        (void)TmFlightRecorderRecord(rec, tm, &frame);
+    }
+    ASSERT_TRUE(TmFlightRecorderIsFrozen(rec));
+    ASSERT_EQ_SIZE(g_triggers, 1);
+    ASSERT_TRUE(g_trigger_kind == TM_HITCH_SINGLE);
+
+    // The spike sits 10 frames before the newest record
+    const size_t count = TmFlightRecorderCount(rec);
+    ASSERT_EQ_SIZE(count, 52);
+    TmFlightRecord record;
+    ASSERT_TRUE(TmFlightRecorderGet(rec, count - 11, &record));
+    ASSERT_TRUE(record.hitch == TM_HITCH_SINGLE);
+    ASSERT_NEAR(record.rawFrameTime, 0.050, 0.0);
+    ASSERT_TRUE(!TmFlightRecorderGet(rec, count, &record));
+
+    // Frozen: nothing is recorded until rearmed
+    const FrameTimingData frame = make_frame(0.016, false);
+    (void)TmFlightRecorderRecord(rec, tm, &frame);
+    ASSERT_EQ_SIZE(TmFlightRecorderCount(rec), 52);
+    TmFlightRecorderRearm(rec);
+    (void)TmFlightRecorderRecord(rec, tm, &frame);
+    ASSERT_EQ_SIZE(TmFlightRecorderCount(rec), 53);
+    ASSERT_TRUE(!TmFlightRecorderIsFrozen(rec));
+
+    TmFlightRecorderDestroy(rec);
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_periodic_hitches(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmFlightRecorderConfig cfg = TmFlightRecorderDefaultConfig();
+    cfg.triggerMask = 1u << TM_HITCH_PERIODIC;
+    cfg.postTriggerFrames = 0;
+    TmFlightRecorder* rec = TmFlightRecorderCreate(&cfg);
+    ASSERT_TRUE(rec != NULL);
+
+    TmHitchKind kinds[4] = {TM_HITCH_NONE, TM_HITCH_NONE, TM_HITCH_NONE, TM_HITCH_NONE};
+    size_t spikes = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        // A spike every 20 frames, with one frame of slack in the third interval
+        const bool isSpike = i == 20 || i == 40 || i == 60 || i == 81;
+        const FrameTimingData frame = make_frame(isSpike ? 0.040 : 0.016, false);
+        const TmHitchKind kind = TmFlightRecorderRecord(rec, tm, &frame);
+        if (isSpike)
+        {
+            kinds[spikes++] = kind;
+        }
+        else
+        {
+            ASSERT_TRUE(kind == TM_HITCH_NONE);
+        }
+        if (i == 40)
+        {
+            // Single hitches are not in the mask
+            ASSERT_TRUE(!TmFlightRecorderIsFrozen(rec));
+        }
+    }
+    ASSERT_TRUE(kinds[0] == TM_HITCH_SINGLE);
+    ASSERT_TRUE(kinds[1] == TM_HITCH_SINGLE);
+    ASSERT_TRUE(kinds[2] == TM_HITCH_PERIODIC);
+    ASSERT_TRUE(kinds[3] == TM_HITCH_PERIODIC);
+    ASSERT_TRUE(TmFlightRecorderIsFrozen(rec));
+
+    const TmHitchStats stats = TmFlightRecorderGetStats(rec);
+    ASSERT_EQ_SIZE(stats.singleHitches, 2);
+    ASSERT_EQ_SIZE(stats.periodicHitches, 2);
+
+    // Frozen right at the third spike
+    TmFlightRecord newest;
+    ASSERT_TRUE(TmFlightRecorderGet(rec, TmFlightRecorderCount(rec) - 1, &newest));
+    ASSERT_TRUE(newest.frameIndex == 60);
+
+    TmFlightRecorderDestroy(rec);
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_sustained_lag(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmFlightRecorderConfig cfg = TmFlightRecorderDefaultConfig();
+    cfg.sustainedLagFrames = 5;
+    cfg.triggerMask = 0;
+    TmFlightRecorder* rec = TmFlightRecorderCreate(&cfg);
+    ASSERT_TRUE(rec != NULL);
+
+    size_t reported = 0;
+    for (int i = 0; i < 30; ++i)
+    {
+        // Lag for frames 0..11 and 20..22; only the first run is long enough
+        const bool lagging = i < 12 || (i >= 20 && i < 23);
+        const FrameTimingData frame = make_frame(0.016, lagging);
+        if (TmFlightRecorderRecord(rec, tm, &frame) == TM_HITCH_SUSTAINED_LAG)
+        {
+            ASSERT_EQ_SIZE((size_t)i, 4);
+            reported++;
+        }
+    }
+    ASSERT_EQ_SIZE(reported, 1);
+    ASSERT_EQ_SIZE(TmFlightRecorderGetStats(rec).sustainedLags, 1);
+    ASSERT_TRUE(!TmFlightRecorderIsFrozen(rec));
+
+    TmFlightRecorderDestroy(rec);
+    TmDestroy(tm);
+    return 0;
+}
+
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+static long long g_cur_ns = 0;
+
+static HighResTimeT fake_now(void)
+{
+    HighResTimeT t;
+    t.nanoseconds = g_cur_ns;
+    return t;
+}
+
+static int test_attached_to_time_manager(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmFlightRecorderConfig cfg = TmFlightRecorderDefaultConfig();
+    cfg.postTriggerFrames = 0;
+    TmFlightRecorder* rec = TmFlightRecorderCreate(&cfg);
+    ASSERT_TRUE(tm != NULL && rec != NULL);
+    g_cur_ns = 1000000000LL;
+    TmSetTimeSource(tm, fake_now);
+    TmAttachFlightRecorder(tm, rec);
+
+    (void)TmBeginFrame(tm);
+    for (int i = 0; i < 30; ++i)
+    {
+        g_cur_ns += 16000000LL;
+        (void)TmBeginFrame(tm);
+    }
+    ASSERT_TRUE(!TmFlightRecorderIsFrozen(rec));
+
+    g_cur_ns += 60000000LL;
+    const FrameTimingData hitch = TmBeginFrame(tm);
+    ASSERT_TRUE(TmFlightRecorderIsFrozen(rec));
+
+    TmFlightRecord record;
+    ASSERT_TRUE(TmFlightRecorderGet(rec, TmFlightRecorderCount(rec) - 1, &record));
+    ASSERT_TRUE(record.hitch == TM_HITCH_SINGLE);
+    ASSERT_NEAR(record.rawFrameTime, 0.060, 1e-9);
+    ASSERT_TRUE(record.tick == hitch.tick);
+    ASSERT_TRUE(record.startNs == g_cur_ns);
+
+    // Phase times are recorded for marked frames and zero once phases stop being marked
+    TmFlightRecorderRearm(rec);
+    TmPhaseBegin(tm, TM_PHASE_SIM);
+    g_cur_ns += 5000000LL;
+    TmPhaseEnd(tm, TM_PHASE_SIM);
+    g_cur_ns += 11000000LL;
+    (void)TmBeginFrame(tm);
+    ASSERT_TRUE(TmFlightRecorderGet(rec, TmFlightRecorderCount(rec) - 1, &record));
+    ASSERT_NEAR(record.phaseTimes[TM_PHASE_SIM], 0.005, 1e-12);
+    g_cur_ns += 16000000LL;
+    (void)TmBeginFrame(tm);
+    ASSERT_TRUE(TmFlightRecorderGet(rec, TmFlightRecorderCount(rec) - 1, &record));
+    for (int phase = 0; phase < TM_PHASE_COUNT; ++phase)
+    {
+        ASSERT_NEAR(record.phaseTimes[phase], 0.0, 0.0);
+    }
+    ASSERT_TRUE(record.perfAvailable == 0);
+
+    // Attached perf counters: each record holds that frame's deltas
+    TmPerfCounters* perf = TmPerfCountersCreate();
+    ASSERT_TRUE(perf != NULL);
+    TmAttachPerfCounters(tm, perf);
+    for (int i = 0; i < 2; ++i)
+    {
+        g_cur_ns += 16000000LL;
+        (void)TmBeginFrame(tm);
+        ASSERT_TRUE(TmFlightRecorderGet(rec, TmFlightRecorderCount(rec) - 1, &record));
+        const TmPerfFrameCounters counters = TmPerfCountersGetFrame(perf);
+        ASSERT_TRUE(record.perfAvailable == counters.available);
+        ASSERT_TRUE(memcmp(record.perfCounters, counters.values, sizeof record.perfCounters) == 0);
+    }
+    TmAttachPerfCounters(tm, NULL);
+    TmPerfCountersDestroy(perf);
+    ASSERT_NEAR(record.threadCpuTime + record.threadWaitTime, 0.0, 0.0);
+
+    // Attached thread usage: each record splits its frame into CPU and wait time
+    TmThreadUsage* usage = TmThreadUsageCreate();
+    ASSERT_TRUE(usage != NULL);
+    TmAttachThreadUsage(tm, usage);
+    for (int i = 0; i < 2; ++i)
+    {
+        g_cur_ns += 16000000LL;
+        (void)TmBeginFrame(tm);
+    }
+    ASSERT_TRUE(TmFlightRecorderGet(rec, TmFlightRecorderCount(rec) - 1, &record));
+    const TmThreadFrameUsage thread = TmThreadUsageGetFrame(usage);
+    ASSERT_NEAR(record.threadCpuTime, thread.cpuTime, 0.0);
+    ASSERT_NEAR(record.threadWaitTime, thread.waitTime, 0.0);
+    ASSERT_NEAR(record.threadCpuTime + record.threadWaitTime, 0.016, 1e-9);
+    ASSERT_TRUE(record.minorFaults == thread.minorFaults && record.majorFaults == thread.majorFaults);
+    TmAttachThreadUsage(tm, NULL);
+    TmThreadUsageDestroy(usage);
+
+    // Detached: frames are no longer seen
+    TmAttachFlightRecorder(tm, NULL);
+    TmFlightRecorderRearm(rec);
+    const size_t count = TmFlightRecorderCount(rec);
+    g_cur_ns += 16000000LL;
+    (void)TmBeginFrame(tm);
+    ASSERT_EQ_SIZE(TmFlightRecorderCount(rec), count);
+
+    TmFlightRecorderDestroy(rec);
+    TmDestroy(tm);
+    return 0;
+}
+#endif
+
+static int test_dump(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmFlightRecorderConfig cfg = TmFlightRecorderDefaultConfig();
+    cfg.capacity = 20;
+    TmFlightRecorder* rec = TmFlightRecorderCreate(&cfg);
+    ASSERT_TRUE(rec != NULL);
+    ASSERT_EQ_SIZE(TmFlightRecorderDumpSize(rec), TM_FLIGHT_RECORDER_HEADER_SIZE);
+
+    // Wraps the ring so the oldest record is frame 5
+    for (int i = 0; i < 25; ++i)
+    {
+        FrameTimingData frame = make_frame(i == 24 ? 0.100 : 0.016, false);
+        frame.tick = (uint64_t)i * 2;
+        (void)TmFlightRecorderRecord(rec, tm, &frame);
+    }
+    const size_t size = TmFlightRecorderDumpSize(rec);
+    ASSERT_EQ_SIZE(size, TM_FLIGHT_RECORDER_HEADER_SIZE + 20 * TM_FLIGHT_RECORD_SERIALIZED_SIZE);
+
+    unsigned char* buffer = malloc(size);
+    ASSERT_TRUE(buffer != NULL);
+    ASSERT_EQ_SIZE(TmFlightRecorderDump(rec, buffer, size - 1), 0);
+    ASSERT_EQ_SIZE(TmFlightRecorderDump(rec, NULL, size), 0);
+    ASSERT_EQ_SIZE(TmFlightRecorderDump(rec, buffer, size), size);
+
+    ASSERT_TRUE(memcmp(buffer, "TMFR", 4) == 0);
+    ASSERT_TRUE(buffer[4] == 3 && buffer[5] == 0);
+    ASSERT_TRUE(buffer[6] == TM_HITCH_SINGLE);
+    ASSERT_EQ_SIZE(read_u32(buffer + 8), 20);
+    ASSERT_EQ_SIZE(read_u32(buffer + 12), TM_FLIGHT_RECORD_SERIALIZED_SIZE);
+    ASSERT_TRUE(read_u64(buffer + 16) == 24);
+
+    const unsigned char* first = buffer + TM_FLIGHT_RECORDER_HEADER_SIZE;
+    ASSERT_TRUE(read_u64(first) == 5);
+    ASSERT_TRUE(read_u64(first + 16) == 10);
+    const unsigned char* last = first + 19 * TM_FLIGHT_RECORD_SERIALIZED_SIZE;
+    ASSERT_TRUE(read_u64(last) == 24);
+    ASSERT_EQ_SIZE(read_u32(last + 68), TM_HITCH_SINGLE);
+
+    // The file holds the same bytes
+    const char* path = "test_flight_recorder.tmfr";
+    ASSERT_TRUE(TmFlightRecorderDumpToFile(rec, path));
+    FILE* file = fopen(path, "rb");
+    ASSERT_TRUE(file != NULL);
+    unsigned char* fromFile = malloc(size + 1);
+    ASSERT_TRUE(fromFile != NULL);
+    const size_t read = fread(fromFile, 1, size + 1, file);
+    fclose(file);
+    remove(path);
+    ASSERT_EQ_SIZE(read, size);
+    ASSERT_TRUE(memcmp(fromFile, buffer, size) == 0);
+
+    free(fromFile);
+    free(buffer);
+    TmFlightRecorderDestroy(rec);
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_invalid_config(void)
+{
+    TmFlightRecorderConfig cfg = TmFlightRecorderDefaultConfig();
+    cfg.capacity = 0;
+    ASSERT_TRUE(TmFlightRecorderCreate(&cfg) == NULL);
+    cfg = TmFlightRecorderDefaultConfig();
+    cfg.spikeFactor = 1.0;
+    ASSERT_TRUE(TmFlightRecorderCreate(&cfg) == NULL);
+    cfg = TmFlightRecorderDefaultConfig();
+    cfg.sustainedLagFrames = 0;
+    ASSERT_TRUE(TmFlightRecorderCreate(&cfg) == NULL);
+    TmFlightRecorderDestroy(NULL);
+    return 0;
+}
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_single_hitch_freezes()))
+        return rc;
+    if ((rc = test_periodic_hitches()))
+        return rc;
+    if ((rc = test_sustained_lag()))
+        return rc;
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+    if ((rc = test_attached_to_time_manager()))
+        return rc;
+#endif
+    if ((rc = test_dump()))
+        return rc;
+    if ((rc = test_invalid_config()))
+        return rc;
+    return 0;
+}
@@ -0,0 +1,153 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "time_manager/frame_predictor.h"
+#include "test_helpers.h"
+
+static uint32_t g_seed = 1;
+
+// Uniform in [-1, 1)
+static double noise(void)
+{
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return (double)(g_seed >> 8) / (double)(1u << 23) - 1.0;
+}
+
+// A renderer whose cost is proportional to pixel count, with +-10% noise
+static double render_cost(const double fullCost, const double scale)
+{
+    return fullCost * scale * scale * (1.0 + 0.1 * noise());
+}
+
+static int test_holds_budget_at_percentile(void)
+{
+    TmFramePredictorConfig cfg = TmFramePredictorDefaultConfig(0.016);
+    TmFramePredictor* p = TmFramePredictorCreate(&cfg);
+    ASSERT_TRUE(p != NULL);
+    ASSERT_NEAR(TmFramePredictorPredict(p).qualityScale, 1.0, 0.0);
+
+    // 24ms at full resolution cannot hold 16ms; the scale must come down
+    size_t within = 0;
+    for (int frame = 0; frame < 600; ++frame)
+    {
+        const TmFramePrediction next = TmFramePredictorPredict(p);
+        const double cost = render_cost(0.024, next.qualityScale);
+        if (frame >= 300)
+        {
+            within += cost <= cfg.targetFrameTime ? 1 : 0;
+            ASSERT_TRUE(next.upperBound <= cfg.targetFrameTime * 1.02);
+        }
+        TmFramePredictorObserve(p, cost);
+    }
+    ASSERT_TRUE(within >= 285);
+
+    const TmFramePrediction settled = TmFramePredictorPredict(p);
+    ASSERT_TRUE(settled.qualityScale > 0.7 && settled.qualityScale < 0.82);
+    ASSERT_TRUE(settled.stddev > 0.0);
+    ASSERT_NEAR(settled.expected, 0.024 * settled.qualityScale * settled.qualityScale, 0.001);
+
+    // One loading hitch moves the scale by at most one step, and it recovers
+    TmFramePredictorObserve(p, 0.2);
+    ASSERT_TRUE(TmFramePredictorPredict(p).qualityScale >= settled.qualityScale * (1.0 - cfg.maxScaleStep) - 1e-12);
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        TmFramePredictorObserve(p, render_cost(0.024, TmFramePredictorPredict(p).qualityScale));
+    }
+    ASSERT_NEAR(TmFramePredictorPredict(p).qualityScale, settled.qualityScale, 0.03);
+
+    // Load goes away: back to full quality, never above the max
+    for (int frame = 0; frame < 200; ++frame)
+    {
+        TmFramePredictorObserve(p, render_cost(0.008, TmFramePredictorPredict(p).qualityScale));
+    }
+    ASSERT_NEAR(TmFramePredictorPredict(p).qualityScale, 1.0, 0.0);
+
+    TmFramePredictorDestroy(p);
+    return 0;
+}
+
+static int test_config_and_frame_feed(void)
+{
+    TmFramePredictorConfig cfg = TmFramePredictorDefaultConfig(0.0);
+    ASSERT_TRUE(TmFramePredictorCreate(&cfg) == NULL);
+    cfg = TmFramePredictorDefaultConfig(0.016);
+    cfg.percentile = 1.0;
+    ASSERT_TRUE(TmFramePredictorCreate(&cfg) == NULL);
+    cfg = TmFramePredictorDefaultConfig(0.016);
+    cfg.minScale = 2.0;
+    ASSERT_TRUE(TmFramePredictorCreate(&cfg) == NULL);
+
+    cfg = TmFramePredictorDefaultConfig(0.016);
+    TmFramePredictor* p = TmFramePredictorCreate(&cfg);
+    TimeManager* tm = TmCreate(NULL);
+
+    // No phases marked: the raw frame time is the cost
+    FrameTimingData frame = {0};
+    frame.rawFrameTime = 0.010;
+    ASSERT_NEAR(TmFramePredictorObserveFrame(p, tm, &frame), 0.010, 0.0);
+    ASSERT_NEAR(TmFramePredictorPredict(p).expected, 0.010, 1e-12);
+
+    // Ignored samples
+    TmFramePredictorObserve(p, 0.0);
+    TmFramePredictorObserve(p, -1.0);
+    ASSERT_NEAR(TmFramePredictorPredict(p).expected, 0.010, 1e-12);
+
+    TmDestroy(tm);
+    TmFramePredictorDestroy(p);
+    return 0;
+}
+
+#if TM_STATS_LEVEL >= TM_STATS_BASIC
+static long long g_cur_ns = 0;
+
+static HighResTimeT fake_now(void)
+{
+    HighResTimeT t;
+    t.nanoseconds = g_cur_ns;
+    return t;
+}
+
+static int test_unmarked_frames_fall_back_to_raw(void)
+{
+    TmFramePredictorConfig cfg = TmFramePredictorDefaultConfig(0.016);
+    TmFramePredictor* p = TmFramePredictorCreate(&cfg);
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now);
+    (void)TmBeginFrame(tm);
+
+    // A marked frame: 4ms of sim in a 16ms frame
+    TmPhaseBegin(tm, TM_PHASE_SIM);
+    g_cur_ns += 4000000;
+    TmPhaseEnd(tm, TM_PHASE_SIM);
+    g_cur_ns += 12000000;
+    FrameTimingData frame = TmBeginFrame(tm);
+    ASSERT_NEAR(TmFramePredictorObserveFrame(p, tm, &frame), 0.004, 1e-12);
+
+    // Loading screen without markers: the cost follows the raw frame time, not the last marked frame
+    for (int i = 1; i <= 3; ++i)
+    {
+        g_cur_ns += i * 10000000LL;
+        frame = TmBeginFrame(tm);
+        ASSERT_NEAR(TmFramePredictorObserveFrame(p, tm, &frame), frame.rawFrameTime, 0.0);
+        ASSERT_NEAR(frame.rawFrameTime, 0.01 * i, 1e-12);
+    }
+
+    TmDestroy(tm);
+    TmFramePredictorDestroy(p);
+    return 0;
+}
+#endif
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_holds_budget_at_percentile()))
+        return rc;
+    if ((rc = test_config_and_frame_feed()))
+        return rc;
+#if TM_STATS_LEVEL >= TM_STATS_BASIC
+    if ((rc = test_unmarked_frames_fall_back_to_raw()))
+        return rc;
+#endif
+    return 0;
+}
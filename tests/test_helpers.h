@@ -0,0 +1,22 @@
+﻿#ifndef TIME_MANAGER_TEST_HELPERS_H
+#define TIME_MANAGER_TEST_HELPERS_H
+
+#include <math.h>
+#include <stdio.h>
+
+// ---------- tiny assert helpers ----------
+#define ASSERT_TRUE(x) do { if (!(x)) { \
+  fprintf(stderr,"ASSERT_TRUE failed: %s:%d: %s\n", __FILE__, __LINE__, #x); \
+  return 1; } } while (0)
+
+#define ASSERT_EQ_SIZE(a,b) do { size_t _aa=(a), _bb=(b); if (_aa!=_bb) { \
+  fprintf(stderr,"ASSERT_EQ_SIZE failed: %s:%d: %zu != %zu\n", __FILE__, __LINE__, _aa, _bb); \
+  return 1; } } while (0)
+
+#define ASSERT_NEAR(a,b,eps) do { double _aa=(a), _bb=(b), _ee=(eps); \
+  if (fabs(_aa-_bb) > _ee) { \
+    fprintf(stderr,"ASSERT_NEAR failed: %s:%d: %.17g vs %.17g (eps=%.1e)\n", \
+            __FILE__, __LINE__, _aa, _bb, _ee); \
+    return 1; } } while (0)
+
+#endif //TIME_MANAGER_TEST_HELPERS_H
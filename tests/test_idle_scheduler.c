@@ -0,0 +1,176 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "time_manager/idle_scheduler.h"
+#include "test_helpers.h"
+
+#define MS(x) ((x) * 1000LL * 1000LL)
+
+// Clock that only moves when a task "works"
+static long long g_now_ns = 0;
+
+static HighResTimeT fake_now(void)
+{
+    return (HighResTimeT){g_now_ns};
+}
+
+typedef struct
+{
+    long long costNs;
+    int runs;
+} Work;
+
+static void cheap_task(void* userData)
+{
+    Work* w = userData;
+    g_now_ns += w->costNs;
+    w->runs++;
+}
+
+static void heavy_task(void* userData)
+{
+    Work* w = userData;
+    g_now_ns += w->costNs;
+    w->runs++;
+}
+
+static TmIdleScheduler* g_reposter;
+
+static void reposting_task(void* userData)
+{
+    Work* w = userData;
+    g_now_ns += w->costNs;
+    w->runs++;
+    (void)TmIdleSchedulerPost(g_reposter, reposting_task, w);
+}
+
+// Starts a frame at the given time
+static void begin_frame_at(TimeManager* tm, const long long ns)
+{
+    g_now_ns = ns;
+    (void)TmBeginFrame(tm);
+}
+
+static int test_runs_until_margin(void)
+{
+    ASSERT_TRUE(TmIdleSchedulerCreate(0, 1.0 / 60.0, DEFAULT_IDLE_MARGIN) == NULL);
+    ASSERT_TRUE(TmIdleSchedulerCreate(DEFAULT_IDLE_TASK_CAPACITY, 0.0, DEFAULT_IDLE_MARGIN) == NULL);
+
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now);
+    TmIdleScheduler* s = TmIdleSchedulerCreate(16, 0.016, DEFAULT_IDLE_MARGIN);
+
+    Work work = {MS(2), 0};
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(TmIdleSchedulerPost(s, cheap_task, &work));
+    }
+    ASSERT_TRUE(TmIdleSchedulerEstimate(s, cheap_task) == 0.0);
+
+    // Frame starts at 0 and the game used 6ms, so 16 - 1 - 6 = 9ms are idle
+    begin_frame_at(tm, 0);
+    g_now_ns = MS(6);
+    const size_t ran = TmIdleSchedulerRun(s, tm);
+    ASSERT_NEAR(TmIdleSchedulerGetStats(s).lastBudget, 0.009, 1e-9);
+
+    // The first run is unknown and runs; after that the learned cost (with headroom) limits the rest
+    ASSERT_TRUE(ran >= 1 && ran <= 4);
+    ASSERT_TRUE(g_now_ns <= MS(15));
+    ASSERT_EQ_SIZE(TmIdleSchedulerPending(s), 10 - ran);
+    ASSERT_EQ_SIZE(TmIdleSchedulerGetStats(s).overruns, 0);
+    ASSERT_TRUE(TmIdleSchedulerGetStats(s).tasksDeferred > 0);
+    ASSERT_TRUE(TmIdleSchedulerEstimate(s, cheap_task) >= 0.002);
+
+    // Later frames drain the queue; steady costs converge so more fit per frame
+    size_t total = ran;
+    for (int frame = 1; frame < 20 && TmIdleSchedulerPending(s) > 0; ++frame)
+    {
+        begin_frame_at(tm, MS(16) * frame);
+        g_now_ns += MS(6);
+        total += TmIdleSchedulerRun(s, tm);
+    }
+    ASSERT_EQ_SIZE(total, 10);
+    ASSERT_EQ_SIZE(work.runs, 10);
+    ASSERT_NEAR(TmIdleSchedulerEstimate(s, cheap_task), 0.002, 0.0015);
+
+    const TmIdleSchedulerStats stats = TmIdleSchedulerGetStats(s);
+    ASSERT_EQ_SIZE(stats.tasksRun, 10);
+    ASSERT_NEAR(stats.timeUsed, 0.020, 1e-9);
+    ASSERT_EQ_SIZE(stats.overruns, 0);
+
+    TmIdleSchedulerDestroy(s);
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_refuses_tasks_that_would_overrun(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now);
+    TmIdleScheduler* s = TmIdleSchedulerCreate(16, 0.016, 0.0);
+
+    // Learn that heavy_task takes 8ms
+    Work heavy = {MS(8), 0};
+    Work cheap = {MS(1), 0};
+    ASSERT_TRUE(TmIdleSchedulerPost(s, heavy_task, &heavy));
+    begin_frame_at(tm, 0);
+    ASSERT_EQ_SIZE(TmIdleSchedulerRun(s, tm), 1);
+
+    // With 5ms left the heavy task waits but the cheap one behind it still runs
+    ASSERT_TRUE(TmIdleSchedulerPost(s, heavy_task, &heavy));
+    ASSERT_TRUE(TmIdleSchedulerPost(s, cheap_task, &cheap));
+    begin_frame_at(tm, MS(16));
+    g_now_ns += MS(11);
+    ASSERT_EQ_SIZE(TmIdleSchedulerRun(s, tm), 1);
+    ASSERT_EQ_SIZE(heavy.runs, 1);
+    ASSERT_EQ_SIZE(cheap.runs, 1);
+    ASSERT_EQ_SIZE(TmIdleSchedulerPending(s), 1);
+
+    // No idle time at all: nothing runs
+    begin_frame_at(tm, MS(32));
+    g_now_ns += MS(20);
+    ASSERT_EQ_SIZE(TmIdleSchedulerRun(s, tm), 0);
+    ASSERT_NEAR(TmIdleSchedulerGetStats(s).lastBudget, 0.0, 0.0);
+
+    // A quiet frame with room for it, including the learned headroom
+    begin_frame_at(tm, MS(64));
+    TmIdleSchedulerSetBudget(s, 0.040, 0.0);
+    ASSERT_EQ_SIZE(TmIdleSchedulerRun(s, tm), 1);
+    ASSERT_EQ_SIZE(heavy.runs, 2);
+
+    TmIdleSchedulerDestroy(s);
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_tasks_posted_while_running_wait(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now);
+    TmIdleScheduler* s = TmIdleSchedulerCreate(4, 1.0, 0.0);
+    g_reposter = s;
+
+    Work w = {MS(1), 0};
+    ASSERT_TRUE(TmIdleSchedulerPost(s, reposting_task, &w));
+    begin_frame_at(tm, 0);
+    ASSERT_EQ_SIZE(TmIdleSchedulerRun(s, tm), 1);
+    ASSERT_EQ_SIZE(TmIdleSchedulerPending(s), 1);
+    ASSERT_EQ_SIZE(TmIdleSchedulerRun(s, tm), 1);
+    ASSERT_EQ_SIZE(w.runs, 2);
+
+    TmIdleSchedulerDestroy(s);
+    TmDestroy(tm);
+    return 0;
+}
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_runs_until_margin()))
+        return rc;
+    if ((rc = test_refuses_tasks_that_would_overrun()))
+        return rc;
+    if ((rc = test_tasks_posted_while_running_wait()))
+        return rc;
+    return 0;
+}
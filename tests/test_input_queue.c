@@ -0,0 +1,159 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "time_manager/input_queue.h"
+#include "test_helpers.h"
+
+#define MS(x) ((x) * 1000LL * 1000LL)
+
+static const long long* g_script = NULL;
+static size_t g_script_len = 0;
+static size_t g_script_idx = 0;
+
+static HighResTimeT fake_now_script(void)
+{
+    const size_t i = (g_script_idx < g_script_len) ? g_script_idx++ : (g_script_len - 1);
+    return (HighResTimeT){g_script[i]};
+}
+
+static void set_script(const long long* arr, size_t n)
+{
+    g_script = arr;
+    g_script_len = n;
+    g_script_idx = 0;
+}
+
+typedef struct
+{
+    int id;
+} KeyEvent;
+
+typedef struct
+{
+    int ids[64];
+    uint64_t ticks[64];
+    size_t count;
+} Received;
+
+static void on_event(void* userData, const void* event, HighResTimeT timestamp, uint64_t tick)
+{
+    (void)timestamp;
+    Received* r = userData;
+    r->ids[r->count] = ((const KeyEvent*)event)->id;
+    r->ticks[r->count] = tick;
+    r->count++;
+}
+
+static HighResTimeT AtMs(const long long ms)
+{
+    return (HighResTimeT){MS(ms)};
+}
+
+static int test_dispatch_by_step_in_timestamp_order(void)
+{
+    // 100 Hz; the second frame at 45ms runs ticks 0..3 and leaves 5ms in the accumulator
+    static const long long script[] = {0LL, 0LL, MS(45)};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetTimeSource(tm, fake_now_script);
+
+    TmInputQueue* q = TmInputQueueCreate(16, sizeof(KeyEvent), NULL);
+    ASSERT_TRUE(q != NULL);
+
+    // Pushed out of order, as racing producer threads would
+    const long long times[] = {33, 5, 12, 48, 23, 12};
+    for (int i = 0; i < 6; ++i)
+    {
+        const KeyEvent e = {i};
+        ASSERT_TRUE(TmInputQueuePushAt(q, &e, AtMs(times[i])));
+    }
+
+    (void)TmBeginFrame(tm);
+    const FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_EQ_SIZE(f.physicsSteps, 4);
+
+    Received r = {0};
+    const size_t expectedPerStep[] = {1, 2, 1, 1};
+    for (size_t i = 0; i < f.physicsSteps; ++i)
+    {
+        ASSERT_EQ_SIZE(TmInputQueueDispatch(q, tm, f.tick + i, on_event, &r), expectedPerStep[i]);
+    }
+
+    // Timestamp order, equal timestamps in push order, each on the step it happened in
+    const int expectedIds[] = {1, 2, 5, 4, 0};
+    const uint64_t expectedTicks[] = {0, 1, 1, 2, 3};
+    ASSERT_EQ_SIZE(r.count, 5);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        ASSERT_TRUE(r.ids[i] == expectedIds[i]);
+        ASSERT_TRUE(r.ticks[i] == expectedTicks[i]);
+    }
+
+    // The 48ms event belongs to tick 4, which has not run yet
+    ASSERT_EQ_SIZE(TmInputQueuePending(q), 1);
+
+    // A late event is dispatched on the next step but reports the step it happened in
+    const KeyEvent late = {9};
+    ASSERT_TRUE(TmInputQueuePushAt(q, &late, AtMs(2)));
+    r.count = 0;
+    ASSERT_EQ_SIZE(TmInputQueueDispatch(q, tm, 4, on_event, &r), 2);
+    ASSERT_TRUE(r.ids[0] == 9 && r.ticks[0] == 0);
+    ASSERT_TRUE(r.ids[1] == 3 && r.ticks[1] == 4);
+    ASSERT_EQ_SIZE(TmInputQueuePending(q), 0);
+
+    TmInputQueueDestroy(q);
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_capacity_and_wraparound(void)
+{
+    ASSERT_TRUE(TmInputQueueCreate(0, sizeof(KeyEvent), NULL) == NULL);
+    ASSERT_TRUE(TmInputQueueCreate(4, 0, NULL) == NULL);
+
+    static const long long script[] = {0LL, 0LL, MS(1000)};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now_script);
+    (void)TmBeginFrame(tm);
+
+    // Stamped with the queue's clock
+    TmInputQueue* q = TmInputQueueCreate(3, sizeof(KeyEvent), fake_now_script);
+    Received r = {0};
+    for (int i = 0; i < 4; ++i)
+    {
+        const KeyEvent e = {i};
+        ASSERT_TRUE(TmInputQueuePush(q, &e));
+    }
+    const KeyEvent overflow = {4};
+    ASSERT_TRUE(!TmInputQueuePush(q, &overflow));
+
+    // Ring and pending set both fill and drain across many laps
+    for (int lap = 0; lap < 100; ++lap)
+    {
+        r.count = 0;
+        ASSERT_EQ_SIZE(TmInputQueueDispatch(q, tm, 100, on_event, &r), 4);
+        for (int i = 0; i < 4; ++i)
+        {
+            ASSERT_TRUE(r.ids[i] == lap * 4 + i);
+            const KeyEvent e = {(lap + 1) * 4 + i};
+            ASSERT_TRUE(TmInputQueuePush(q, &e));
+        }
+        ASSERT_TRUE(!TmInputQueuePush(q, &overflow));
+    }
+
+    TmInputQueueDestroy(q);
+    TmDestroy(tm);
+    return 0;
+}
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_dispatch_by_step_in_timestamp_order()))
+        return rc;
+    if ((rc = test_capacity_and_wraparound()))
+        return rc;
+    return 0;
+}
@@ -0,0 +1,237 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "time_manager/jitter_buffer.h"
+#include "test_helpers.h"
+
+#define SERVER_HZ 60.0
+#define TICKS_PER_SNAPSHOT 3
+#define SNAPSHOTS 600
+#define FRAME_NS 16666667LL
+
+typedef struct
+{
+    uint64_t tick;
+} Snapshot;
+
+static HighResTimeT AtNs(const int64_t ns)
+{
+    return (HighResTimeT){ns};
+}
+
+static int64_t ServerNs(const uint64_t tick)
+{
+    return (int64_t)llround((double)tick * 1e9 / SERVER_HZ);
+}
+
+static double Position(const TmJitterSample* s)
+{
+    return (double)s->fromTick + s->alpha * (double)(s->toTick - s->fromTick);
+}
+
+// Plays back snapshots every TICKS_PER_SNAPSHOT ticks with the given arrival times, rendering at 60 Hz.
+static int PlayBack(TmJitterBuffer* jb, const int64_t* arrivals, size_t* underruns, double* maxRateError)
+{
+    bool pushed[SNAPSHOTS] = {false};
+    double lastPosition = -1.0;
+    bool lastUnderrun = true;
+    *underruns = 0;
+    *maxRateError = 0.0;
+
+    // Run a little past the last send so every snapshot arrives
+    const int64_t end = ServerNs(SNAPSHOTS * TICKS_PER_SNAPSHOT);
+    for (int64_t now = 0; now < end + 100000000LL; now += FRAME_NS)
+    {
+        for (size_t i = 0; i < SNAPSHOTS; ++i)
+        {
+            if (!pushed[i] && arrivals[i] <= now)
+            {
+                const Snapshot snap = {i * TICKS_PER_SNAPSHOT};
+                TmJitterBufferPush(jb, snap.tick, AtNs(arrivals[i]), &snap);
+                pushed[i] = true;
+            }
+        }
+
+        TmJitterSample s;
+        if (!TmJitterBufferSample(jb, AtNs(now), &s))
+        {
+            continue;
+        }
+        ASSERT_TRUE(((const Snapshot*)s.from)->tick == s.fromTick);
+        ASSERT_TRUE(((const Snapshot*)s.to)->tick == s.toTick);
+        ASSERT_TRUE(s.alpha >= 0.0 && s.alpha <= 1.0);
+
+        // Skip the first second while the jitter estimate settles, and the tail where the stream ends
+        if (now > 1000000000LL && now < end)
+        {
+            const double position = Position(&s);
+            ASSERT_TRUE(position >= lastPosition);
+            if (!lastUnderrun && !s.underrun)
+            {
+                // One frame is one server tick at 1x
+                *maxRateError = fmax(*maxRateError, fabs(position - lastPosition - 1.0));
+            }
+            lastPosition = position;
+            lastUnderrun = s.underrun;
+            if (s.underrun)
+            {
+                (*underruns)++;
+            }
+        }
+    }
+    return 0;
+}
+
+static int test_create_and_empty(void)
+{
+    TmJitterBufferConfig cfg = TmJitterBufferDefaultConfig(sizeof(Snapshot), SERVER_HZ);
+    TmJitterBuffer* jb = TmJitterBufferCreate(&cfg);
+    ASSERT_TRUE(jb != NULL);
+
+    TmJitterSample s;
+    ASSERT_TRUE(!TmJitterBufferSample(jb, AtNs(0), &s));
+    const Snapshot first = {0};
+    TmJitterBufferPush(jb, 0, AtNs(0), &first);
+    ASSERT_TRUE(!TmJitterBufferSample(jb, AtNs(0), &s));
+    TmJitterBufferDestroy(jb);
+
+    cfg.serverTickRate = 0.0;
+    ASSERT_TRUE(TmJitterBufferCreate(&cfg) == NULL);
+    cfg = TmJitterBufferDefaultConfig(sizeof(Snapshot), SERVER_HZ);
+    cfg.percentile = 1.5;
+    ASSERT_TRUE(TmJitterBufferCreate(&cfg) == NULL);
+    cfg = TmJitterBufferDefaultConfig(0, SERVER_HZ);
+    ASSERT_TRUE(TmJitterBufferCreate(&cfg) == NULL);
+    return 0;
+}
+
+static int test_steady_arrivals_use_minimal_delay(void)
+{
+    TmJitterBufferConfig cfg = TmJitterBufferDefaultConfig(sizeof(Snapshot), SERVER_HZ);
+    TmJitterBuffer* jb = TmJitterBufferCreate(&cfg);
+
+    static int64_t arrivals[SNAPSHOTS];
+    for (size_t i = 0; i < SNAPSHOTS; ++i)
+    {
+        arrivals[i] = ServerNs(i * TICKS_PER_SNAPSHOT) + 40000000LL;
+    }
+
+    size_t underruns;
+    double maxRateError;
+    int rc = PlayBack(jb, arrivals, &underruns, &maxRateError);
+    if (rc)
+        return rc;
+
+    const TmJitterBufferStats stats = TmJitterBufferGetStats(jb);
+    ASSERT_EQ_SIZE(stats.received, SNAPSHOTS);
+    ASSERT_EQ_SIZE(stats.late, 0);
+    ASSERT_NEAR(stats.jitter, 0.0, 1e-6);
+    ASSERT_NEAR(stats.snapshotInterval, TICKS_PER_SNAPSHOT / SERVER_HZ, 1e-6);
+    ASSERT_EQ_SIZE(underruns, 0);
+    ASSERT_NEAR(maxRateError, 0.0, 1e-6);
+
+    // Delay is one snapshot interval plus the safety margin behind the freshest data, no more
+    TmJitterSample s;
+    ASSERT_TRUE(TmJitterBufferSample(jb, AtNs(ServerNs(SNAPSHOTS * TICKS_PER_SNAPSHOT) + 100000000LL), &s));
+    ASSERT_NEAR(s.targetDelay, TICKS_PER_SNAPSHOT / SERVER_HZ + cfg.minDelay, 1e-6);
+    ASSERT_NEAR(s.delay, s.targetDelay, 1e-6);
+
+    TmJitterBufferDestroy(jb);
+    return 0;
+}
+
+static int test_jitter_adapts_delay_smoothly(void)
+{
+    TmJitterBufferConfig cfg = TmJitterBufferDefaultConfig(sizeof(Snapshot), SERVER_HZ);
+    TmJitterBuffer* jb = TmJitterBufferCreate(&cfg);
+
+    // Uniform 0..30 ms jitter on top of a 40 ms base transit, delivered out of order
+    static int64_t arrivals[SNAPSHOTS];
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < SNAPSHOTS; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const int64_t jitter = (int64_t)((seed >> 8) % 30000u) * 1000LL;
+        arrivals[i] = ServerNs(i * TICKS_PER_SNAPSHOT) + 40000000LL + jitter;
+    }
+
+    size_t underruns;
+    double maxRateError;
+    int rc = PlayBack(jb, arrivals, &underruns, &maxRateError);
+    if (rc)
+        return rc;
+
+    const TmJitterBufferStats stats = TmJitterBufferGetStats(jb);
+    ASSERT_TRUE(stats.jitter > 0.020 && stats.jitter < 0.030);
+    ASSERT_TRUE(underruns < 10);
+
+    // Playback never jumps: per-frame speed stays within the configured warp
+    ASSERT_TRUE(maxRateError <= cfg.maxRateAdjust + 1e-6);
+
+    TmJitterSample s;
+    ASSERT_TRUE(TmJitterBufferSample(jb, AtNs(ServerNs(SNAPSHOTS * TICKS_PER_SNAPSHOT) + 100000000LL), &s));
+    ASSERT_NEAR(s.targetDelay, stats.jitter + stats.snapshotInterval, 1e-9); // jitter exceeds the margin
+    ASSERT_NEAR(s.delay, s.targetDelay, 0.005);
+
+    TmJitterBufferDestroy(jb);
+    return 0;
+}
+
+static int test_underrun_and_gaps(void)
+{
+    TmJitterBufferConfig cfg = TmJitterBufferDefaultConfig(sizeof(Snapshot), SERVER_HZ);
+    TmJitterBuffer* jb = TmJitterBufferCreate(&cfg);
+
+    // Tick 6 is lost; interpolation bridges 3 -> 9
+    const uint64_t ticks[] = {0, 3, 9};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const Snapshot snap = {ticks[i]};
+        TmJitterBufferPush(jb, ticks[i], AtNs(ServerNs(ticks[i])), &snap);
+    }
+
+    TmJitterSample s;
+    ASSERT_TRUE(TmJitterBufferSample(jb, AtNs(ServerNs(9)), &s));
+    ASSERT_TRUE(!s.underrun);
+
+    // Step playback into the gap
+    int64_t now = ServerNs(9);
+    while (Position(&s) < 4.0)
+    {
+        now += FRAME_NS;
+        ASSERT_TRUE(TmJitterBufferSample(jb, AtNs(now), &s));
+    }
+    ASSERT_TRUE(s.fromTick == 3 && s.toTick == 9);
+
+    // No more data: playback keeps going and holds the newest snapshot
+    for (int i = 0; i < 20; ++i)
+    {
+        now += FRAME_NS;
+        ASSERT_TRUE(TmJitterBufferSample(jb, AtNs(now), &s));
+    }
+    ASSERT_TRUE(s.underrun);
+    ASSERT_TRUE(s.fromTick == 9 && s.toTick == 9);
+    ASSERT_TRUE(TmJitterBufferGetStats(jb).underruns > 0);
+
+    // A snapshot for a tick already played is still accepted but counted as late
+    const Snapshot old = {6};
+    TmJitterBufferPush(jb, 6, AtNs(now), &old);
+    ASSERT_EQ_SIZE(TmJitterBufferGetStats(jb).late, 1);
+
+    TmJitterBufferDestroy(jb);
+    return 0;
+}
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_create_and_empty()))
+        return rc;
+    if ((rc = test_steady_arrivals_use_minimal_delay()))
+        return rc;
+    if ((rc = test_jitter_adapts_delay_smoothly()))
+        return rc;
+    if ((rc = test_underrun_and_gaps()))
+        return rc;
+    return 0;
+}
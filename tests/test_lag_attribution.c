@@ -0,0 +1,224 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <string.h>
+#include "time_manager/lag_attribution.h"
+#include "test_helpers.h"
+
+static FrameTimingData make_frame(const double raw, const bool lagging, const double dropped)
+{
+    FrameTimingData frame;
+    memset(&frame, 0, sizeof frame);
+    frame.rawFrameTime = raw;
+    frame.lagging = lagging;
+    frame.droppedTime = dropped;
+    return frame;
+}
+
+static int test_missing_sources(void)
+{
+    TmLagAttributionConfig cfg = TmLagAttributionDefaultConfig();
+    cfg.cpuStatPath = "no_such_directory/cpu.stat";
+    cfg.procStatPath = "no_such_directory/stat";
+    TmLagAttribution* lag = TmLagAttributionCreate(&cfg);
+    ASSERT_TRUE(lag != NULL);
+    ASSERT_TRUE(!TmLagAttributionGetStats(lag).hasThrottling);
+    ASSERT_TRUE(!TmLagAttributionGetStats(lag).hasSteal);
+
+    // Without sources everything lost is "other"
+    const FrameTimingData frame = make_frame(0.3, true, 0.05);
+    const TmLagFrameAttribution a = TmLagAttributionRecord(lag, &frame);
+    ASSERT_NEAR(a.lostTime, 0.05, 0.0);
+    ASSERT_NEAR(a.lostToOther, 0.05, 1e-12);
+    ASSERT_NEAR(a.lostToThrottling + a.lostToSteal, 0.0, 0.0);
+    ASSERT_EQ_SIZE(TmLagAttributionGetStats(lag).lagFrames, 1);
+    TmLagAttributionDestroy(lag);
+
+    // The real system may or may not have the sources; creation succeeds either way
+    lag = TmLagAttributionCreate(NULL);
+    ASSERT_TRUE(lag != NULL);
+    const FrameTimingData normal = make_frame(0.016, false, 0.0);
+    const TmLagFrameAttribution b = TmLagAttributionRecord(lag, &normal);
+    ASSERT_TRUE(b.throttledTime + b.stealTime <= 0.016 + 1e-12);
+    TmLagAttributionDestroy(lag);
+    TmLagAttributionDestroy(NULL);
+    return 0;
+}
+
+#ifdef __linux__
+static const char* CPU_STAT_PATH = "test_lag_cpu.stat";
+static const char* PROC_STAT_PATH = "test_lag_proc.stat";
+
+// Rewrites the fake sources in place, as the kernel would update them
+static void write_sources(const unsigned long long throttledPeriods, const unsigned long long throttledUsec,
+                          const unsigned long long steal, const unsigned long long idle)
+{
+    FILE* file = fopen(CPU_STAT_PATH, "w");
+    fprintf(file, "usage_usec 1000\nuser_usec 800\nsystem_usec 200\nnr_periods 50\nnr_throttled %llu\n"
+                  "throttled_usec %llu\n", throttledPeriods, throttledUsec);
+    fclose(file);
+    file = fopen(PROC_STAT_PATH, "w");
+    fprintf(file, "cpu  1000 0 500 %llu 0 0 0 %llu 0 0\ncpu0 1000 0 500 %llu 0 0 0 %llu 0 0\n", idle, steal, idle,
+            steal);
+    fclose(file);
+}
+
+static int test_attributes_lost_time(void)
+{
+    write_sources(0, 0, 0, 10000);
+    TmLagAttributionConfig cfg = TmLagAttributionDefaultConfig();
+    cfg.cpuStatPath = CPU_STAT_PATH;
+    cfg.procStatPath = PROC_STAT_PATH;
+    TmLagAttribution* lag = TmLagAttributionCreate(&cfg);
+    ASSERT_TRUE(lag != NULL);
+    ASSERT_TRUE(TmLagAttributionGetStats(lag).hasThrottling);
+    ASSERT_TRUE(TmLagAttributionGetStats(lag).hasSteal);
+
+    // A quiet frame does not read the sources, so the change is only seen by the next lagging frame
+    const FrameTimingData quiet = make_frame(0.016, false, 0.0);
+    write_sources(2, 100000, 250, 10750);
+    TmLagFrameAttribution a = TmLagAttributionRecord(lag, &quiet);
+    ASSERT_TRUE(!a.sampled);
+    ASSERT_NEAR(a.throttledTime, 0.0, 0.0);
+    ASSERT_NEAR(a.stealTime, 0.0, 0.0);
+
+    // 200ms frame: throttled for 100ms, and a quarter of all CPU time was stolen
+    const FrameTimingData slow = make_frame(0.2, true, 0.1);
+    a = TmLagAttributionRecord(lag, &slow);
+    ASSERT_TRUE(a.sampled);
+    ASSERT_NEAR(a.throttledTime, 0.1, 1e-12);
+    ASSERT_NEAR(a.stealTime, 0.05, 1e-12);
+    ASSERT_NEAR(a.lostToThrottling, 0.05, 1e-12);
+    ASSERT_NEAR(a.lostToSteal, 0.025, 1e-12);
+    ASSERT_NEAR(a.lostToOther, 0.025, 1e-12);
+
+    // Throttled time summed over many CPUs is capped at the frame, leaving nothing for steal
+    write_sources(10, 2100000, 500, 11500);
+    const FrameTimingData capped = make_frame(0.2, true, 0.04);
+    a = TmLagAttributionRecord(lag, &capped);
+    ASSERT_NEAR(a.throttledTime, 0.2, 1e-12);
+    ASSERT_NEAR(a.stealTime, 0.0, 1e-12);
+    ASSERT_NEAR(a.lostToThrottling, 0.04, 1e-12);
+
+    const TmLagAttributionStats stats = TmLagAttributionGetStats(lag);
+    ASSERT_EQ_SIZE(stats.frames, 3);
+    ASSERT_EQ_SIZE(stats.lagFrames, 2);
+    ASSERT_TRUE(stats.throttledPeriods == 10);
+    ASSERT_NEAR(stats.lostTime, 0.14, 1e-12);
+    ASSERT_NEAR(stats.lostToThrottling, 0.09, 1e-12);
+    ASSERT_NEAR(stats.lostToSteal, 0.025, 1e-12);
+    ASSERT_NEAR(stats.lostToOther, 0.025, 1e-12);
+
+    TmLagAttributionDestroy(lag);
+    remove(CPU_STAT_PATH);
+    remove(PROC_STAT_PATH);
+    return 0;
+}
+
+static int test_baseline_refresh(void)
+{
+    write_sources(0, 0, 0, 10000);
+    TmLagAttributionConfig cfg = TmLagAttributionDefaultConfig();
+    cfg.cpuStatPath = CPU_STAT_PATH;
+    cfg.procStatPath = PROC_STAT_PATH;
+    cfg.refreshInterval = 0.05;
+    TmLagAttribution* lag = TmLagAttributionCreate(&cfg);
+    ASSERT_TRUE(lag != NULL);
+
+    // Throttled for 32ms and a quarter stolen, spread over quiet frames that do not read the sources
+    write_sources(1, 32000, 100, 10300);
+    const FrameTimingData quiet = make_frame(0.016, false, 0.0);
+    TmLagFrameAttribution a;
+    for (int i = 0; i < 3; ++i)
+    {
+        a = TmLagAttributionRecord(lag, &quiet);
+        ASSERT_TRUE(!a.sampled);
+    }
+    ASSERT_NEAR(TmLagAttributionGetStats(lag).throttledTime, 0.0, 0.0);
+
+    // The fourth frame passes the interval and reads the 64ms window: the frame takes what fits of it
+    a = TmLagAttributionRecord(lag, &quiet);
+    ASSERT_TRUE(a.sampled);
+    ASSERT_NEAR(a.throttledTime, 0.016, 1e-12);
+    ASSERT_NEAR(a.stealTime, 0.0, 1e-12);
+
+    TmLagAttributionStats stats = TmLagAttributionGetStats(lag);
+    ASSERT_EQ_SIZE(stats.frames, 4);
+    ASSERT_TRUE(stats.throttledPeriods == 1);
+    ASSERT_NEAR(stats.throttledTime, 0.032, 1e-12);
+    ASSERT_NEAR(stats.stealTime, 0.016, 1e-12);
+
+    // The window restarts after a read
+    a = TmLagAttributionRecord(lag, &quiet);
+    ASSERT_TRUE(!a.sampled);
+    TmLagAttributionDestroy(lag);
+
+    // Zero reads every frame
+    cfg.refreshInterval = 0.0;
+    lag = TmLagAttributionCreate(&cfg);
+    ASSERT_TRUE(lag != NULL);
+    a = TmLagAttributionRecord(lag, &quiet);
+    ASSERT_TRUE(a.sampled);
+    TmLagAttributionDestroy(lag);
+
+    remove(CPU_STAT_PATH);
+    remove(PROC_STAT_PATH);
+    return 0;
+}
+#endif
+
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+static long long g_cur_ns = 0;
+
+static HighResTimeT fake_now(void)
+{
+    HighResTimeT t;
+    t.nanoseconds = g_cur_ns;
+    return t;
+}
+
+static int test_recorded_by_begin_frame(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmLagAttribution* lag = TmLagAttributionCreate(NULL);
+    ASSERT_TRUE(tm != NULL && lag != NULL);
+    TmSetTimeSource(tm, fake_now);
+    TmAttachLagAttribution(tm, lag);
+
+    (void)TmBeginFrame(tm);
+    g_cur_ns += 16666667;
+    (void)TmBeginFrame(tm);
+    // Long enough to exceed maxPhysicsSteps
+    g_cur_ns += 200000000;
+    const FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_TRUE(f.lagging);
+
+    const TmLagAttributionStats stats = TmLagAttributionGetStats(lag);
+    ASSERT_EQ_SIZE(stats.frames, 2);
+    ASSERT_EQ_SIZE(stats.lagFrames, 1);
+    ASSERT_NEAR(stats.lostTime, f.droppedTime, 1e-12);
+    ASSERT_NEAR(stats.lostToThrottling + stats.lostToSteal + stats.lostToOther, f.droppedTime, 1e-12);
+
+    TmAttachLagAttribution(tm, NULL);
+    TmLagAttributionDestroy(lag);
+    TmDestroy(tm);
+    return 0;
+}
+#endif
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_missing_sources()))
+        return rc;
+#ifdef __linux__
+    if ((rc = test_attributes_lost_time()))
+        return rc;
+    if ((rc = test_baseline_refresh()))
+        return rc;
+#endif
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+    if ((rc = test_recorded_by_begin_frame()))
+        return rc;
+#endif
+    return 0;
+}
@@ -0,0 +1,156 @@
+﻿#include <stdio.h>
+#include "time_manager/perf_counters.h"
+#include "test_helpers.h"
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+static volatile double g_sink = 0.0;
+
+static void busy_work_n(const int iterations)
+{
+    double x = 1.0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        x = x * 1.0000001 + 0.5;
+    }
+    g_sink = x;
+}
+
+static void busy_work(void)
+{
+    busy_work_n(200000);
+}
+
+// Blocks briefly so the thread is switched out
+static void yield_cpu(const int times)
+{
+#ifdef __linux__
+    const struct timespec pause = {0, 200000};
+    for (int i = 0; i < times; ++i)
+    {
+        nanosleep(&pause, NULL);
+    }
+#else
+    (void)times;
+#endif
+}
+
+static int test_sample_deltas(void)
+{
+    TmPerfCounters* counters = TmPerfCountersCreate();
+    ASSERT_TRUE(counters != NULL);
+    const uint32_t available = TmPerfCountersAvailable(counters);
+    ASSERT_TRUE(TmPerfCountersGetFrame(counters).available == 0);
+
+    busy_work();
+    const TmPerfFrameCounters frame = TmPerfCountersSample(counters);
+    ASSERT_TRUE(frame.available == available);
+    for (int counter = 0; counter < TM_PERF_COUNTER_COUNT; ++counter)
+    {
+        // Unavailable counters read as zero; the others are deltas, not running totals
+        if (!(available & (1u << counter)))
+        {
+            ASSERT_TRUE(frame.values[counter] == 0);
+        }
+    }
+    if (available & (1u << TM_PERF_INSTRUCTIONS))
+    {
+        ASSERT_TRUE(frame.values[TM_PERF_INSTRUCTIONS] > 200000);
+        ASSERT_TRUE(frame.running > 0.0 && frame.running <= 1.0);
+    }
+    if (available & (1u << TM_PERF_CYCLES) && available & (1u << TM_PERF_INSTRUCTIONS))
+    {
+        ASSERT_TRUE(frame.instructionsPerCycle > 0.0);
+    }
+    else
+    {
+        ASSERT_NEAR(frame.instructionsPerCycle, 0.0, 0.0);
+    }
+
+    const TmPerfFrameCounters last = TmPerfCountersGetFrame(counters);
+    ASSERT_TRUE(last.values[TM_PERF_INSTRUCTIONS] == frame.values[TM_PERF_INSTRUCTIONS]);
+
+    TmPerfCountersDestroy(counters);
+    TmPerfCountersDestroy(NULL);
+    return 0;
+}
+
+static int test_samples_are_not_cumulative(void)
+{
+    TmPerfCounters* counters = TmPerfCountersCreate();
+    ASSERT_TRUE(counters != NULL);
+    const uint32_t available = TmPerfCountersAvailable(counters);
+
+    // A heavy frame followed by a light one: a running total could never shrink
+    busy_work_n(4000000);
+    yield_cpu(40);
+    const TmPerfFrameCounters heavy = TmPerfCountersSample(counters);
+    busy_work_n(200000);
+    yield_cpu(2);
+    const TmPerfFrameCounters light = TmPerfCountersSample(counters);
+
+    if (available & (1u << TM_PERF_INSTRUCTIONS))
+    {
+        ASSERT_TRUE(light.values[TM_PERF_INSTRUCTIONS] < heavy.values[TM_PERF_INSTRUCTIONS]);
+    }
+    if (available & (1u << TM_PERF_CONTEXT_SWITCHES))
+    {
+        ASSERT_TRUE(heavy.values[TM_PERF_CONTEXT_SWITCHES] >= 40);
+        ASSERT_TRUE(light.values[TM_PERF_CONTEXT_SWITCHES] < heavy.values[TM_PERF_CONTEXT_SWITCHES]);
+    }
+
+    TmPerfCountersDestroy(counters);
+    return 0;
+}
+
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+static long long g_cur_ns = 0;
+
+static HighResTimeT fake_now(void)
+{
+    HighResTimeT t;
+    t.nanoseconds = g_cur_ns;
+    return t;
+}
+
+static int test_sampled_by_begin_frame(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmPerfCounters* counters = TmPerfCountersCreate();
+    ASSERT_TRUE(tm != NULL && counters != NULL);
+    TmSetTimeSource(tm, fake_now);
+    TmAttachPerfCounters(tm, counters);
+
+    (void)TmBeginFrame(tm);
+    busy_work();
+    g_cur_ns += 16000000;
+    (void)TmBeginFrame(tm);
+    const TmPerfFrameCounters frame = TmPerfCountersGetFrame(counters);
+    ASSERT_TRUE(frame.available == TmPerfCountersAvailable(counters));
+    if (frame.available & (1u << TM_PERF_INSTRUCTIONS))
+    {
+        ASSERT_TRUE(frame.values[TM_PERF_INSTRUCTIONS] > 200000);
+    }
+
+    TmAttachPerfCounters(tm, NULL);
+    TmPerfCountersDestroy(counters);
+    TmDestroy(tm);
+    return 0;
+}
+#endif
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_sample_deltas()))
+        return rc;
+    if ((rc = test_samples_are_not_cumulative()))
+        return rc;
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+    if ((rc = test_sampled_by_begin_frame()))
+        return rc;
+#endif
+    return 0;
+}
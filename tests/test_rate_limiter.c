@@ -0,0 +1,89 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "time_manager/rate_limiter.h"
+#include "test_helpers.h"
+
+static int test_consume_and_refill(void)
+{
+    ASSERT_TRUE(TmRateLimiterCreate(0, 1.0, 1.0) == NULL);
+    ASSERT_TRUE(TmRateLimiterCreate(4, -1.0, 1.0) == NULL);
+    ASSERT_TRUE(TmRateLimiterCreate(4, 1.0, 0.0) == NULL);
+
+    // 10 tokens/s, bursts of 3
+    TmRateLimiter* rl = TmRateLimiterCreate(4, 10.0, 3.0);
+    ASSERT_TRUE(rl != NULL);
+    ASSERT_EQ_SIZE(TmRateLimiterBucketCount(rl), 4);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(TmRateLimiterTryConsume(rl, 0, 1.0));
+    }
+    ASSERT_TRUE(!TmRateLimiterTryConsume(rl, 0, 1.0));
+    ASSERT_NEAR(TmRateLimiterTokens(rl, 1), 3.0, 0.0);
+
+    // Ten refills of a hundredth of a second make exactly one token despite rounding
+    for (int i = 0; i < 10; ++i)
+    {
+        TmRateLimiterRefill(rl, 0.01);
+    }
+    ASSERT_TRUE(TmRateLimiterTryConsume(rl, 0, 1.0));
+    ASSERT_TRUE(!TmRateLimiterTryConsume(rl, 0, 1.0));
+    ASSERT_NEAR(TmRateLimiterTokens(rl, 0), 0.0, 0.0);
+
+    // Refill is capped at the burst, negative time is ignored
+    TmRateLimiterRefill(rl, 100.0);
+    ASSERT_NEAR(TmRateLimiterTokens(rl, 0), 3.0, 0.0);
+    TmRateLimiterRefill(rl, -1.0);
+    ASSERT_NEAR(TmRateLimiterTokens(rl, 0), 3.0, 0.0);
+
+    // A failed consume takes nothing
+    ASSERT_TRUE(!TmRateLimiterTryConsume(rl, 0, 3.5));
+    ASSERT_NEAR(TmRateLimiterTokens(rl, 0), 3.0, 0.0);
+
+    TmRateLimiterDestroy(rl);
+    return 0;
+}
+
+static int test_per_bucket_rates_from_frames(void)
+{
+    TmRateLimiter* rl = TmRateLimiterCreate(3, 60.0, 1.0);
+    TmRateLimiterSetBucket(rl, 1, 30.0, 2.0);
+    TmRateLimiterSetBucket(rl, 2, 0.0, 0.5);
+    ASSERT_NEAR(TmRateLimiterTokens(rl, 2), 0.5, 0.0);
+
+    // Drive refills from the steps the TimeManager ran: 60 Hz, one action per step at most
+    TimeManager* tm = TmCreate(NULL);
+    size_t accepted[3] = {0};
+    for (int i = 0; i < 120; ++i)
+    {
+        const FrameTimingData f = TmAdvanceSteps(tm, 1);
+        TmRateLimiterRefill(rl, (double)f.physicsSteps * f.fixedTimestep);
+        for (size_t b = 0; b < 3; ++b)
+        {
+            accepted[b] += TmRateLimiterTryConsume(rl, b, 1.0) ? 1 : 0;
+        }
+    }
+    ASSERT_EQ_SIZE(accepted[0], 120);
+    ASSERT_EQ_SIZE(accepted[1], 2 + 60 - 1);
+    ASSERT_EQ_SIZE(accepted[2], 0);
+
+    TmRateLimiterResetBucket(rl, 1);
+    ASSERT_NEAR(TmRateLimiterTokens(rl, 1), 2.0, 0.0);
+    TmRateLimiterSetBucket(rl, 1, 30.0, 1.0);
+    ASSERT_NEAR(TmRateLimiterTokens(rl, 1), 1.0, 0.0);
+
+    TmDestroy(tm);
+    TmRateLimiterDestroy(rl);
+    return 0;
+}
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_consume_and_refill()))
+        return rc;
+    if ((rc = test_per_bucket_rates_from_frames()))
+        return rc;
+    return 0;
+}
@@ -0,0 +1,127 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "time_manager/thread_usage.h"
+#include "test_helpers.h"
+
+static volatile double g_sink = 0.0;
+
+// Spins until the thread has used at least the given CPU time
+static void burn_cpu(TmThreadUsage* usage, const double seconds)
+{
+    double used = 0.0;
+    double x = 1.0;
+    while (used < seconds)
+    {
+        for (int i = 0; i < 100000; ++i)
+        {
+            x = x * 1.0000001 + 0.5;
+        }
+        used += TmThreadUsageSample(usage, 0.0).cpuTime;
+    }
+    g_sink = x;
+}
+
+static int test_cpu_and_wait_split(void)
+{
+    TmThreadUsage* usage = TmThreadUsageCreate();
+    ASSERT_TRUE(usage != NULL);
+    ASSERT_NEAR(TmThreadUsageGetFrame(usage).wallTime, 0.0, 0.0);
+
+    burn_cpu(usage, 0.02);
+
+    // A 1 second frame of which almost nothing was CPU time: the rest was waiting
+    const TmThreadFrameUsage idle = TmThreadUsageSample(usage, 1.0);
+    ASSERT_NEAR(idle.wallTime, 1.0, 0.0);
+    ASSERT_TRUE(idle.cpuTime < 0.5);
+    ASSERT_NEAR(idle.waitTime, 1.0 - idle.cpuTime, 1e-12);
+
+    // CPU time beyond the reported wall time never makes the wait negative
+    burn_cpu(usage, 0.0);
+    const TmThreadFrameUsage busy = TmThreadUsageSample(usage, 0.0);
+    ASSERT_NEAR(busy.waitTime, 0.0, 0.0);
+    ASSERT_NEAR(TmThreadUsageGetFrame(usage).cpuTime, busy.cpuTime, 0.0);
+
+    TmThreadUsageDestroy(usage);
+    TmThreadUsageDestroy(NULL);
+    return 0;
+}
+
+static int test_faults(void)
+{
+    TmThreadUsage* usage = TmThreadUsageCreate();
+    ASSERT_TRUE(usage != NULL);
+
+    // Touch fresh pages; each first touch is a minor fault
+    const size_t size = 8u << 20;
+    char* memory = malloc(size);
+    ASSERT_TRUE(memory != NULL);
+    memset(memory, 1, size);
+    const TmThreadFrameUsage frame = TmThreadUsageSample(usage, 0.1);
+    g_sink = memory[size / 2];
+    free(memory);
+
+#ifdef __linux__
+    ASSERT_TRUE(frame.hasFaults);
+    ASSERT_TRUE(frame.minorFaults > 0);
+#else
+    ASSERT_TRUE(!frame.hasFaults);
+    ASSERT_TRUE(frame.minorFaults == 0);
+#endif
+
+    TmThreadUsageDestroy(usage);
+    return 0;
+}
+
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+static long long g_cur_ns = 0;
+
+static HighResTimeT fake_now(void)
+{
+    HighResTimeT t;
+    t.nanoseconds = g_cur_ns;
+    return t;
+}
+
+static int test_sampled_by_begin_frame(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmThreadUsage* usage = TmThreadUsageCreate();
+    ASSERT_TRUE(tm != NULL && usage != NULL);
+    TmSetTimeSource(tm, fake_now);
+
+    // CPU time used before attaching is not charged to the first frame
+    burn_cpu(usage, 0.02);
+    TmAttachThreadUsage(tm, usage);
+    (void)TmBeginFrame(tm);
+    g_cur_ns += 50000000;
+    (void)TmBeginFrame(tm);
+    ASSERT_NEAR(TmThreadUsageGetFrame(usage).wallTime, 0.0, 0.0);
+    ASSERT_NEAR(TmThreadUsageGetFrame(usage).cpuTime, 0.0, 0.0);
+
+    g_cur_ns += 50000000;
+    const FrameTimingData f = TmBeginFrame(tm);
+    const TmThreadFrameUsage frame = TmThreadUsageGetFrame(usage);
+    ASSERT_NEAR(frame.wallTime, f.rawFrameTime, 0.0);
+    ASSERT_NEAR(frame.cpuTime + frame.waitTime, 0.05, 1e-9);
+    ASSERT_TRUE(frame.cpuTime < 0.01);
+
+    TmAttachThreadUsage(tm, NULL);
+    TmThreadUsageDestroy(usage);
+    TmDestroy(tm);
+    return 0;
+}
+#endif
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_cpu_and_wait_split()))
+        return rc;
+    if ((rc = test_faults()))
+        return rc;
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+    if ((rc = test_sampled_by_begin_frame()))
+        return rc;
+#endif
+    return 0;
+}
@@ -0,0 +1,114 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "time_manager/tick_history.h"
+#include "test_helpers.h"
+
+typedef struct
+{
+    float x, y;
+    unsigned char flags;
+} EntityRecord;
+
+static int test_write_get_and_eviction(void)
+{
+    ASSERT_TRUE(TmTickHistoryCreate(0, sizeof(EntityRecord)) == NULL);
+    ASSERT_TRUE(TmTickHistoryCreate(8, 0) == NULL);
+
+    TmTickHistory* h = TmTickHistoryCreate(5, sizeof(EntityRecord));
+    ASSERT_TRUE(h != NULL);
+    ASSERT_EQ_SIZE(TmTickHistoryCapacity(h), 8);
+    ASSERT_EQ_SIZE(TmTickHistoryRecordSize(h), sizeof(EntityRecord));
+    ASSERT_TRUE(TmTickHistoryGet(h, 0) == NULL);
+
+    for (uint64_t tick = 0; tick < 20; ++tick)
+    {
+        const EntityRecord r = {(float)tick, (float)tick * 2.0f, 0};
+        TmTickHistoryPush(h, tick, &r);
+    }
+
+    // Only the last 8 ticks survive
+    ASSERT_TRUE(TmTickHistoryGet(h, 11) == NULL);
+    for (uint64_t tick = 12; tick < 20; ++tick)
+    {
+        const EntityRecord* r = TmTickHistoryGet(h, tick);
+        ASSERT_TRUE(r != NULL);
+        ASSERT_NEAR(r->x, (double)tick, 0.0);
+    }
+    ASSERT_TRUE(TmTickHistoryGet(h, 20) == NULL);
+
+    // Records are contiguous and aligned
+    EntityRecord* a = TmTickHistoryWrite(h, 100);
+    EntityRecord* b = TmTickHistoryWrite(h, 101);
+    ASSERT_EQ_SIZE((size_t)((unsigned char*)b - (unsigned char*)a), 16);
+    ASSERT_EQ_SIZE((size_t)a % 16, 0);
+
+    TmTickHistoryDestroy(h);
+    return 0;
+}
+
+static int test_sample_by_sim_time(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100); // 10ms ticks
+
+    TmTickHistory* h = TmTickHistoryCreate(64, sizeof(EntityRecord));
+    ASSERT_TRUE(h != NULL);
+    for (int i = 0; i < 50; ++i)
+    {
+        const FrameTimingData f = TmAdvanceSteps(tm, 1);
+        const EntityRecord r = {(float)(f.tick + 1), 0.0f, 0};
+        TmTickHistoryPush(h, f.tick + 1, &r);
+    }
+
+    // 123ms lies 30% of the way from tick 12 to tick 13
+    TmHistorySample sample;
+    ASSERT_TRUE(TmTickHistorySample(h, tm, 123LL * 1000 * 1000, &sample));
+    ASSERT_EQ_SIZE((size_t)sample.fromTick, 12);
+    ASSERT_EQ_SIZE((size_t)sample.toTick, 13);
+    ASSERT_NEAR(sample.alpha, 0.3, 1e-9);
+    ASSERT_NEAR(((const EntityRecord*)sample.from)->x, 12.0, 0.0);
+    ASSERT_NEAR(((const EntityRecord*)sample.to)->x, 13.0, 0.0);
+
+    // Exactly on the latest tick needs no next record
+    ASSERT_TRUE(TmTickHistorySample(h, tm, 500LL * 1000 * 1000, &sample));
+    ASSERT_TRUE(sample.from == sample.to);
+    ASSERT_NEAR(sample.alpha, 0.0, 0.0);
+
+    // Past the latest tick or before the first stored one
+    ASSERT_TRUE(!TmTickHistorySample(h, tm, 505LL * 1000 * 1000, &sample));
+    ASSERT_TRUE(!TmTickHistorySample(h, tm, 5LL * 1000 * 1000, &sample));
+
+    TmTickHistoryDestroy(h);
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_tick_at_sim_time_boundaries(void)
+{
+    // 60 Hz ticks are not whole nanoseconds; conversions must agree at every boundary
+    TimeManager* tm = TmCreate(NULL);
+    for (uint64_t tick = 0; tick < 1000; ++tick)
+    {
+        const int64_t t = TmGetSimTimeAtTick(tm, tick);
+        const TmTickPosition at = TmGetTickAtSimTime(tm, t);
+        ASSERT_TRUE(at.tick == tick);
+        ASSERT_NEAR(at.fraction, 0.0, 0.0);
+        ASSERT_TRUE(TmGetTickAtSimTime(tm, t - 1).tick + (tick > 0 ? 1 : 0) == tick);
+    }
+    ASSERT_TRUE(TmGetTickAtSimTime(tm, -5).tick == 0);
+    TmDestroy(tm);
+    return 0;
+}
+
+int main(void)
+{
+    int rc = 0;
+    if ((rc = test_write_get_and_eviction()))
+        return rc;
+    if ((rc = test_sample_by_sim_time()))
+        return rc;
+    if ((rc = test_tick_at_sim_time_boundaries()))
+        return rc;
+    return 0;
+}
@@ -2,21 +2,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "time_manager/time_manager.h"  // pulls in utils/time_utils.h
-
-// ---------- tiny assert helpers ----------
-#define ASSERT_TRUE(x) do { if (!(x)) { \
-  fprintf(stderr,"ASSERT_TRUE failed: %s:%d: %s\n", __FILE__, __LINE__, #x); \
-  return 1; } } while (0)
-
-#define ASSERT_EQ_SIZE(a,b) do { size_t _aa=(a), _bb=(b); if (_aa!=_bb) { \
-  fprintf(stderr,"ASSERT_EQ_SIZE failed: %s:%d: %zu != %zu\n", __FILE__, __LINE__, _aa, _bb); \
-  return 1; } } while (0)
-
-#define ASSERT_NEAR(a,b,eps) do { double _aa=(a), _bb=(b), _ee=(eps); \
-  if (fabs(_aa-_bb) > _ee) { \
-    fprintf(stderr,"ASSERT_NEAR failed: %s:%d: %.17g vs %.17g (eps=%.1e)\n", \
-            __FILE__, __LINE__, _aa, _bb, _ee); \
-    return 1; } } while (0)
+#include "test_helpers.h"
 
 // ---------- fake clocks ----------
 // A) Scripted clock (steps through a provided array of nanoseconds)
@@ -237,6 +223,7 @@ static int test_cap_and_raw_delta(void)
     ASSERT_NEAR(f.rawFrameTime, 1.5, 1e-12);
     ASSERT_NEAR(f.unscaledFrameTime, 0.10, 1e-12); // capped
     ASSERT_NEAR(f.frameTime, 0.10, 1e-12);         // scale=1.0
+    ASSERT_NEAR(f.droppedTime, 1.40 + 1.0 / 60.0, 1e-9); // cap + 6th step over maxPhysicsSteps
 
     TmDestroy(tm);
 
@@ -255,6 +242,7 @@ static int test_pause_resume(void)
     return 0;
 }
 
+#if TM_STATS_LEVEL >= TM_STATS_BASIC
 static int test_average_fps(void)
 {
     // Use steady 20ms frames → exactly 50 frames per second when summed to 1.0s+
@@ -276,6 +264,798 @@ static int test_average_fps(void)
     TmDestroy(tm);
     return 0;
 }
+#endif
+
+static int test_headless_advance(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetMaxPhysicsSteps(tm, 2);
+
+    // Exact step count, no clamping to maxPhysicsSteps
+    const FrameTimingData f0 = TmAdvanceSteps(tm, 1000);
+    ASSERT_EQ_SIZE(f0.physicsSteps, 1000);
+    ASSERT_TRUE(!f0.lagging);
+    ASSERT_NEAR(f0.frameTime, 10.0, 1e-9);
+    ASSERT_NEAR(f0.rawFrameTime, 0.0, 1e-12);
+    ASSERT_NEAR(TmGetAccumulator(tm), 0.0, 1e-12);
+
+    // Sim duration ignores the time scale and keeps the remainder
+    TmSetTimeScale(tm, 0.5);
+    const FrameTimingData f1 = TmAdvanceSimTime(tm, 0.125);
+    ASSERT_EQ_SIZE(f1.physicsSteps, 12);
+    ASSERT_NEAR(f1.frameTime, 0.125, 1e-12);
+    ASSERT_NEAR(f1.interpolationAlpha, 0.5, 1e-9);
+    ASSERT_EQ_SIZE(TmAdvanceSimTime(tm, 0.005).physicsSteps, 1);
+    ASSERT_NEAR(TmGetAccumulator(tm), 0.0, 1e-9);
+
+    // Many exact steps through the accumulator must not drop or double count any
+    TmSetPhysicsHz(tm, 60);
+    size_t total = 0;
+    for (int i = 0; i < 6000; ++i)
+    {
+        total += TmAdvanceSimTime(tm, 1.0 / 60.0).physicsSteps;
+    }
+    ASSERT_EQ_SIZE(total, 6000);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_headless_matches_realtime(void)
+{
+    // 7ms frames at 100 Hz, real-time vs headless
+    TimeManager* rt = TmCreate(NULL);
+    TimeManager* hl = TmCreate(NULL);
+    TmSetPhysicsHz(rt, 100);
+    TmSetPhysicsHz(hl, 100);
+    set_steady(0LL, 7LL * 1000 * 1000);
+    TmSetTimeSource(rt, fake_now_steady);
+
+    (void)TmBeginFrame(rt);
+    size_t rtSteps = 0, hlSteps = 0;
+    for (int i = 0; i < 500; ++i)
+    {
+        rtSteps += TmBeginFrame(rt).physicsSteps;
+        hlSteps += TmAdvanceSimTime(hl, 0.007).physicsSteps;
+        ASSERT_EQ_SIZE(rtSteps, hlSteps);
+    }
+    ASSERT_NEAR(TmGetAccumulator(rt), TmGetAccumulator(hl), 1e-9);
+
+    TmDestroy(rt);
+    TmDestroy(hl);
+    return 0;
+}
+
+typedef struct
+{
+    size_t calls;
+    size_t steps;
+    size_t largestBatch;
+    uint64_t firstTicks[64];
+} BatchCounter;
+
+static void count_batch(void* userData, uint64_t firstTick, size_t stepCount, double fixedTimestep)
+{
+    BatchCounter* counter = userData;
+    (void)fixedTimestep;
+    counter->firstTicks[counter->calls % 64] = firstTick;
+    counter->calls++;
+    counter->steps += stepCount;
+    if (stepCount > counter->largestBatch)
+    {
+        counter->largestBatch = stepCount;
+    }
+}
+
+static int test_fast_forward(void)
+{
+    TimeManager* tm = TmCreate(NULL); // 60 Hz, 0.25s cap, 5 steps max
+
+    // 10 minute gap: 36000 steps, computed without touching the manager
+    ASSERT_EQ_SIZE(TmComputeCatchUpSteps(tm, 600.0), 36000);
+    ASSERT_NEAR(TmGetAccumulator(tm), 0.0, 1e-12);
+
+    BatchCounter counter = {0};
+    ASSERT_EQ_SIZE(TmFastForward(tm, 600.0, 1000, count_batch, &counter), 36000);
+    ASSERT_EQ_SIZE(counter.steps, 36000);
+    ASSERT_EQ_SIZE(counter.calls, 36);
+    ASSERT_EQ_SIZE(counter.largestBatch, 1000);
+    ASSERT_EQ_SIZE((size_t)counter.firstTicks[1], 1000);
+    ASSERT_EQ_SIZE((size_t)counter.firstTicks[35], 35000);
+    ASSERT_EQ_SIZE((size_t)TmGetTick(tm), 36000);
+
+    // Time scale applies to the wall-clock interval, remainder is kept
+    TmSetTimeScale(tm, 2.0);
+    ASSERT_EQ_SIZE(TmComputeCatchUpSteps(tm, 0.025), 3);
+    ASSERT_EQ_SIZE(TmFastForward(tm, 0.025, 0, count_batch, &counter), 3);
+    ASSERT_NEAR(TmGetAccumulator(tm), 0.05 - 3.0 / 60.0, 1e-9);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_dropped_time_from_step_clamp(void)
+{
+    // 100 Hz with at most 2 steps: a 50ms frame runs 2 steps and drops the other 30ms
+    static const long long script[] = {0LL, 0LL, 50LL * 1000 * 1000};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetMaxPhysicsSteps(tm, 2);
+    TmSetTimeSource(tm, fake_now_script);
+
+    (void)TmBeginFrame(tm);
+    const FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_TRUE(f.lagging);
+    ASSERT_NEAR(f.droppedTime, 0.03, 1e-9);
+
+    ASSERT_TRUE(llabs(f.unscaledTimeNs - 20LL * 1000 * 1000) <= 1);
+
+    // Fast-forwarding the dropped time accounts for the whole 50ms exactly once
+    BatchCounter counter = {0};
+    ASSERT_EQ_SIZE(TmFastForward(tm, f.droppedTime, 0, count_batch, &counter), 3);
+    ASSERT_TRUE(llabs(TmGetUnscaledTimeNs(tm) - 50LL * 1000 * 1000) <= 1);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static double stiffness_from(void* userData)
+{
+    return *(const double*)userData;
+}
+
+static int test_substeps(void)
+{
+    static const long long script[] = {0LL, 0LL, 20LL * 1000 * 1000};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetTimeSource(tm, fake_now_script);
+
+    // Default: no substepping
+    TmSubstepInfo info = TmComputeSubsteps(tm);
+    ASSERT_EQ_SIZE(info.substeps, 1);
+    ASSERT_NEAR(info.substepDt, 0.01, 1e-12);
+
+    // Fixed divisor
+    TmSetSubstepDivisor(tm, 4);
+    info = TmComputeSubsteps(tm);
+    ASSERT_EQ_SIZE(info.substeps, 4);
+    ASSERT_NEAR(info.substepDt, 0.0025, 1e-12);
+    ASSERT_NEAR(TmSubstepAlpha(&info, 0), 0.25, 1e-12);
+    ASSERT_NEAR(TmSubstepAlpha(&info, 3), 1.0, 1e-12);
+
+    // Metric rounds up and clamps to [1, maxSubsteps]
+    double stiffness = 2.3;
+    TmSetSubstepMetric(tm, stiffness_from, &stiffness, 6);
+    ASSERT_EQ_SIZE(TmComputeSubsteps(tm).substeps, 3);
+    stiffness = 40.0;
+    ASSERT_EQ_SIZE(TmComputeSubsteps(tm).substeps, 6);
+    stiffness = 0.1;
+    ASSERT_EQ_SIZE(TmComputeSubsteps(tm).substeps, 1);
+
+    TmSubstepStats stats = TmGetSubstepStats(tm);
+    ASSERT_EQ_SIZE(stats.steps, 5);
+    ASSERT_EQ_SIZE(stats.substeps, 15);
+    ASSERT_EQ_SIZE(stats.maxSubsteps, 6);
+    ASSERT_NEAR(stats.averageSubsteps, 3.0, 1e-12);
+
+    // Per-frame counters roll over on the next frame, the lifetime average is kept
+    (void)TmBeginFrame(tm);
+    (void)TmBeginFrame(tm);
+    stats = TmGetSubstepStats(tm);
+    ASSERT_EQ_SIZE(stats.steps, 0);
+    ASSERT_EQ_SIZE(stats.substeps, 0);
+    ASSERT_NEAR(stats.averageSubsteps, 3.0, 1e-12);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_extrapolation_mode(void)
+{
+    // 100 Hz, frames of 25ms: 2 steps and 5ms past the latest step
+    static const long long script[] = {0LL, 0LL, 25LL * 1000 * 1000, 50LL * 1000 * 1000};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetTimeSource(tm, fake_now_script);
+    ASSERT_TRUE(TmGetRenderMode(tm) == TM_RENDER_INTERPOLATE);
+
+    (void)TmBeginFrame(tm);
+    const FrameTimingData interp = TmBeginFrame(tm);
+    ASSERT_NEAR(interp.interpolationAlpha, 0.5, 1e-9);
+    ASSERT_NEAR(interp.extrapolationTime, 0.0, 1e-12);
+
+    TmSetRenderMode(tm, TM_RENDER_EXTRAPOLATE);
+    const FrameTimingData extrap = TmBeginFrame(tm);
+    ASSERT_EQ_SIZE(extrap.physicsSteps, 3);
+    ASSERT_NEAR(extrap.interpolationAlpha, 1.0, 1e-9); // exactly on a step
+    ASSERT_NEAR(extrap.extrapolationTime, 0.0, 1e-9);
+
+    const FrameTimingData headless = TmAdvanceSimTime(tm, 0.0075);
+    ASSERT_NEAR(headless.interpolationAlpha, 1.75, 1e-9);
+    ASSERT_NEAR(headless.extrapolationTime, 0.0075, 1e-9);
+
+    // Cap
+    TmSetMaxExtrapolationAlpha(tm, 1.5);
+    ASSERT_NEAR(TmAdvanceSteps(tm, 0).interpolationAlpha, 1.5, 1e-12);
+    TmSetMaxExtrapolationAlpha(tm, 0.2);
+    ASSERT_NEAR(TmGetMaxExtrapolationAlpha(tm), 1.0, 1e-12);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_extrapolate_positions(void)
+{
+    // Odd count exercises both the vector body and the scalar tail
+    float pos[13], vel[13], out[13];
+    for (int i = 0; i < 13; ++i)
+    {
+        pos[i] = (float)i;
+        vel[i] = (float)(i % 3) - 1.0f;
+    }
+
+    TmExtrapolatePositions(out, pos, vel, 13, 0.5f);
+    for (int i = 0; i < 13; ++i)
+    {
+        ASSERT_NEAR(out[i], (double)i + ((double)(i % 3) - 1.0) * 0.5, 1e-6);
+    }
+
+    // In place
+    TmExtrapolatePositions(pos, pos, vel, 13, 0.5f);
+    for (int i = 0; i < 13; ++i)
+    {
+        ASSERT_NEAR(pos[i], out[i], 0.0);
+    }
+
+    return 0;
+}
+
+static int test_latched_timing(void)
+{
+    // 100 Hz, frame at 24ms leaves 4ms in the accumulator
+    static const long long script[] = {0LL, 0LL, 24LL * 1000 * 1000};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetTimeSource(tm, fake_now_script);
+    (void)TmBeginFrame(tm);
+    const FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_NEAR(f.interpolationAlpha, 0.4, 1e-9);
+
+    // Presented 3ms later: alpha 0.7, accumulator untouched
+    const HighResTimeT present = {.nanoseconds = 27LL * 1000 * 1000};
+    TmLatchedTiming latched = TmLatchTiming(tm, present);
+    ASSERT_NEAR(latched.interpolationAlpha, 0.7, 1e-9);
+    ASSERT_NEAR(latched.simTimeSinceStep, 0.007, 1e-9);
+    ASSERT_NEAR(latched.timeSinceFrame, 0.003, 1e-9);
+    ASSERT_TRUE(llabs(latched.simTimeNs - 27LL * 1000 * 1000) <= 1);
+    ASSERT_NEAR(TmGetAccumulator(tm), 0.004, 1e-9);
+
+    // Interpolation cannot go past the latest state, extrapolation can
+    const HighResTimeT late = {.nanoseconds = 33LL * 1000 * 1000};
+    ASSERT_NEAR(TmLatchTiming(tm, late).interpolationAlpha, 1.0, 1e-12);
+    TmSetRenderMode(tm, TM_RENDER_EXTRAPOLATE);
+    latched = TmLatchTiming(tm, late);
+    ASSERT_NEAR(latched.interpolationAlpha, 2.0, 1e-9);
+    ASSERT_NEAR(latched.extrapolationTime, 0.01, 1e-9);
+
+    // Time scale applies, earlier timestamps clamp to the frame start
+    TmSetTimeScale(tm, 0.5);
+    ASSERT_NEAR(TmLatchTiming(tm, present).simTimeSinceStep, 0.0055, 1e-9);
+    const HighResTimeT early = {.nanoseconds = 0};
+    ASSERT_NEAR(TmLatchTiming(tm, early).simTimeSinceStep, 0.004, 1e-9);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_timing_state_save_restore(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetTimeScale(tm, 0.75);
+    (void)TmAdvanceSimTime(tm, 0.025);
+
+    TmTimingState saved;
+    TmSaveTimingState(tm, &saved);
+    ASSERT_NEAR(saved.accumulator, 0.005, 1e-9);
+
+    // Diverge, then rewind
+    TmPause(tm);
+    TmSetPhysicsHz(tm, 30);
+    (void)TmAdvanceSimTime(tm, 0.5);
+    TmRestoreTimingState(tm, &saved);
+    ASSERT_NEAR(TmGetAccumulator(tm), 0.005, 1e-12);
+    ASSERT_EQ_SIZE(TmGetPhysicsHz(tm), 100);
+    ASSERT_NEAR(TmGetTimeScale(tm), 0.75, 1e-12);
+    ASSERT_TRUE(!TmIsPaused(tm));
+
+    // Pause state round-trips, including the scale to resume to
+    TmPause(tm);
+    TmSaveTimingState(tm, &saved);
+    TmResume(tm);
+    TmRestoreTimingState(tm, &saved);
+    ASSERT_TRUE(TmIsPaused(tm));
+    TmResume(tm);
+    ASSERT_NEAR(TmGetTimeScale(tm), 0.75, 1e-12);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_timing_state_serialization(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 120);
+    TmSetTimeScale(tm, 1.25);
+    (void)TmAdvanceSimTime(tm, 0.013);
+
+    TmTimingState state;
+    TmSaveTimingState(tm, &state);
+
+    unsigned char buffer[TM_TIMING_STATE_SERIALIZED_SIZE];
+    ASSERT_EQ_SIZE(TmSerializeTimingState(&state, buffer, sizeof buffer - 1), 0);
+    ASSERT_EQ_SIZE(TmSerializeTimingState(&state, buffer, sizeof buffer), TM_TIMING_STATE_SERIALIZED_SIZE);
+    ASSERT_TRUE(buffer[0] == 'T' && buffer[1] == 'M' && buffer[2] == 'S' && buffer[3] == 'T');
+
+    TmTimingState decoded;
+    ASSERT_TRUE(TmDeserializeTimingState(&decoded, buffer, sizeof buffer));
+    ASSERT_NEAR(decoded.accumulator, state.accumulator, 0.0);
+    ASSERT_NEAR(decoded.physicsTimeStep, state.physicsTimeStep, 0.0);
+    ASSERT_NEAR(decoded.timeScale, state.timeScale, 0.0);
+    ASSERT_EQ_SIZE((size_t)decoded.physicsHz, 120);
+
+    // "Migrate" into a fresh manager
+    TimeManager* other = TmCreate(NULL);
+    TmRestoreTimingState(other, &decoded);
+    ASSERT_EQ_SIZE(TmAdvanceSimTime(other, 0.01).physicsSteps, TmAdvanceSimTime(tm, 0.01).physicsSteps);
+    ASSERT_NEAR(TmGetAccumulator(other), TmGetAccumulator(tm), 0.0);
+
+    // Truncated or corrupted input is rejected
+    ASSERT_TRUE(!TmDeserializeTimingState(&decoded, buffer, sizeof buffer - 1));
+    buffer[0] = 'X';
+    ASSERT_TRUE(!TmDeserializeTimingState(&decoded, buffer, sizeof buffer));
+
+    TmDestroy(other);
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_tick_and_sim_clock(void)
+{
+    // 60 Hz with a step clamp: ticks only count steps actually issued
+    static const long long script[] = {0LL, 0LL, 100LL * 1000 * 1000, 500LL * 1000 * 1000};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now_script);
+
+    const FrameTimingData f0 = TmBeginFrame(tm);
+    ASSERT_EQ_SIZE((size_t)f0.tick, 0);
+    ASSERT_TRUE(f0.simTimeNs == 0);
+
+    const FrameTimingData f1 = TmBeginFrame(tm); // 100ms -> 6 steps, clamped to 5
+    ASSERT_EQ_SIZE((size_t)f1.tick, 0);
+    ASSERT_EQ_SIZE(f1.physicsSteps, 5);
+    ASSERT_EQ_SIZE((size_t)TmGetTick(tm), 5);
+    ASSERT_TRUE(f1.simTimeNs == 83333333LL); // floor(5 * 1e9 / 60)
+    // The step dropped by the clamp was not fed into the simulation
+    ASSERT_TRUE(llabs(f1.unscaledTimeNs - 83333333LL) <= 1);
+
+    const FrameTimingData f2 = TmBeginFrame(tm); // 400ms, capped to 250ms
+    ASSERT_EQ_SIZE((size_t)f2.tick, 5);
+    // 15 steps at the cap, 10 of them dropped by the clamp
+    ASSERT_TRUE(llabs(f2.unscaledTimeNs - 166666667LL) <= 1);
+    ASSERT_EQ_SIZE((size_t)(f2.tick + f2.physicsSteps), (size_t)TmGetTick(tm));
+
+    // Exact: one simulated hour at 60 Hz is exactly 3600s, no drift
+    TimeManager* hl = TmCreate(NULL);
+    (void)TmAdvanceSteps(hl, 60 * 3600);
+    ASSERT_TRUE(TmGetSimTimeNs(hl) == 3600LL * 1000 * 1000 * 1000);
+
+    // Timestep changes continue the clock from where it was
+    TmSetPhysicsHz(hl, 100);
+    const FrameTimingData h = TmAdvanceSteps(hl, 50);
+    ASSERT_TRUE(h.simTimeNs == 3600LL * 1000 * 1000 * 1000 + 500LL * 1000 * 1000);
+    ASSERT_TRUE(TmGetSimTimeAtTick(hl, 60 * 3600) == 3600LL * 1000 * 1000 * 1000);
+
+    // Snapshots carry the clocks
+    TmTimingState state;
+    TmSaveTimingState(hl, &state);
+    (void)TmAdvanceSteps(hl, 7);
+    TmRestoreTimingState(hl, &state);
+    ASSERT_TRUE(TmGetTick(hl) == 60 * 3600 + 50);
+    ASSERT_TRUE(TmGetSimTimeNs(hl) == h.simTimeNs);
+
+    TmReset(hl);
+    ASSERT_TRUE(TmGetTick(hl) == 0 && TmGetSimTimeNs(hl) == 0);
+
+    TmDestroy(hl);
+    TmDestroy(tm);
+    return 0;
+}
+
+typedef struct
+{
+    uint64_t lastTick;
+    size_t position;
+    size_t savedPosition;
+    size_t saves;
+    size_t restores;
+} SpeculativeWorld;
+
+static void world_save(void* userData)
+{
+    SpeculativeWorld* w = userData;
+    w->savedPosition = w->position;
+    w->saves++;
+}
+
+static void world_restore(void* userData)
+{
+    SpeculativeWorld* w = userData;
+    w->position = w->savedPosition;
+    w->restores++;
+}
+
+static void world_step(void* userData, uint64_t tick, double fixedTimestep)
+{
+    SpeculativeWorld* w = userData;
+    (void)fixedTimestep;
+    w->lastTick = tick;
+    w->position++;
+}
+
+static int test_run_ahead(void)
+{
+    // Every clock read advances 1ms
+    set_steady(0LL, 1LL * 1000 * 1000);
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now_steady);
+
+    // Disabled by default
+    ASSERT_EQ_SIZE(TmBeginRunAhead(tm), 0);
+    TmEndRunAhead(tm);
+
+    SpeculativeWorld world = {0};
+    const TmRunAheadCallbacks callbacks = {world_save, world_restore, world_step, &world};
+    TmSetRunAhead(tm, 2, &callbacks);
+
+    (void)TmAdvanceSteps(tm, 10);
+    world.position = 10;
+    (void)TmBeginFrame(tm);
+
+    ASSERT_EQ_SIZE(TmBeginRunAhead(tm), 2);
+    ASSERT_EQ_SIZE(world.position, 12);      // speculative state to render
+    ASSERT_EQ_SIZE((size_t)world.lastTick, 11);
+    ASSERT_EQ_SIZE((size_t)TmGetTick(tm), 10); // real tick untouched
+    TmEndRunAhead(tm);
+    ASSERT_EQ_SIZE(world.position, 10);
+    ASSERT_EQ_SIZE(world.saves, 1);
+    ASSERT_EQ_SIZE(world.restores, 1);
+    ASSERT_NEAR(TmGetAccumulator(tm), 0.0, 1e-12);
+
+    // Costs come from the system clock; the manager's clock is not read, so the next frame is 1ms
+    const FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_NEAR(f.rawFrameTime, 0.001, 1e-12);
+
+    const TmRunAheadStats stats = TmGetRunAheadStats(tm);
+    ASSERT_EQ_SIZE(stats.steps, 2);
+    ASSERT_TRUE(stats.saveTime >= 0.0 && stats.stepTime >= 0.0 && stats.restoreTime >= 0.0);
+    ASSERT_NEAR(stats.averageTime, stats.saveTime + stats.stepTime + stats.restoreTime, 1e-12);
+    ASSERT_NEAR(stats.maxTime, stats.averageTime, 0.0);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_resimulate(void)
+{
+    set_steady(0LL, 2LL * 1000 * 1000);
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now_steady);
+    (void)TmAdvanceSteps(tm, 100);
+    (void)TmBeginFrame(tm);
+
+    // Server acked tick 95: replay steps 95..99 to get back to tick 100
+    SpeculativeWorld world = {0};
+    ASSERT_EQ_SIZE(TmResimulate(tm, 95, world_step, &world), 5);
+    ASSERT_EQ_SIZE(world.position, 5);
+    ASSERT_EQ_SIZE((size_t)world.lastTick, 99);
+    ASSERT_EQ_SIZE((size_t)TmGetTick(tm), 100);
+
+    // Acks at or past the present tick replay nothing and are not corrections
+    const TmResimulationStats before = TmGetResimulationStats(tm);
+    ASSERT_EQ_SIZE(TmResimulate(tm, 100, world_step, &world), 0);
+    ASSERT_EQ_SIZE(TmResimulate(tm, 120, world_step, &world), 0);
+    ASSERT_EQ_SIZE(world.position, 5);
+
+    const TmResimulationStats stats = TmGetResimulationStats(tm);
+    ASSERT_EQ_SIZE(stats.steps, 5);
+    ASSERT_EQ_SIZE(stats.corrections, 1);
+    ASSERT_EQ_SIZE(stats.maxSteps, 5);
+    ASSERT_NEAR(stats.time, before.time, 0.0);
+    ASSERT_NEAR(stats.averageTime, stats.time, 0.0);
+    ASSERT_TRUE(stats.time >= 0.0);
+
+    // Timed with the system clock: the next frame sees exactly one 2ms clock step
+    const FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_NEAR(f.rawFrameTime, 0.002, 1e-12);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_map_timestamp_to_tick(void)
+{
+    // 100 Hz; frames at 0, 45ms and 50ms, then a 1s hitch capped to 250ms
+    static const long long script[] = {0LL, 0LL, 45LL * 1000 * 1000, 50LL * 1000 * 1000, 1050LL * 1000 * 1000};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetMaxPhysicsSteps(tm, 100);
+    TmSetTimeSource(tm, fake_now_script);
+    const HighResTimeT input = {.nanoseconds = 23LL * 1000 * 1000};
+
+    // Before any frame everything maps to the current tick
+    TmTickPosition p = TmMapTimestampToTick(tm, input);
+    ASSERT_TRUE(p.tick == 0);
+
+    (void)TmBeginFrame(tm);
+    FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_EQ_SIZE(f.physicsSteps, 4);
+
+    // Input during the frame lands on the step covering it, not the frame's first step
+    p = TmMapTimestampToTick(tm, input);
+    ASSERT_TRUE(p.tick == 2);
+    ASSERT_NEAR(p.fraction, 0.3, 1e-6);
+
+    // After the latest frame: projected, including the 5ms left in the accumulator
+    const HighResTimeT pending = {.nanoseconds = 48LL * 1000 * 1000};
+    p = TmMapTimestampToTick(tm, pending);
+    ASSERT_TRUE(p.tick == 4);
+    ASSERT_NEAR(p.fraction, 0.8, 1e-6);
+
+    // Same answer once the next frame has run the step
+    f = TmBeginFrame(tm);
+    ASSERT_TRUE(f.tick == 4 && f.physicsSteps == 1);
+    p = TmMapTimestampToTick(tm, pending);
+    ASSERT_TRUE(p.tick == 4);
+    ASSERT_NEAR(p.fraction, 0.8, 1e-6);
+    p = TmMapTimestampToTick(tm, input);
+    ASSERT_TRUE(p.tick == 2);
+
+    // Time past the hitch cap was never simulated and collapses onto the next frame
+    f = TmBeginFrame(tm);
+    ASSERT_EQ_SIZE(f.physicsSteps, 25);
+    const HighResTimeT inHitch = {.nanoseconds = 100LL * 1000 * 1000};
+    p = TmMapTimestampToTick(tm, inHitch);
+    ASSERT_TRUE(p.tick == 10);
+    ASSERT_NEAR(p.fraction, 0.0, 1e-6);
+    const HighResTimeT dropped = {.nanoseconds = 900LL * 1000 * 1000};
+    p = TmMapTimestampToTick(tm, dropped);
+    ASSERT_TRUE(p.tick == 30);
+
+    // Time scale stretches the mapping
+    TmSetTimeScale(tm, 0.5);
+    const HighResTimeT later = {.nanoseconds = 1070LL * 1000 * 1000};
+    p = TmMapTimestampToTick(tm, later);
+    ASSERT_TRUE(p.tick == 31);
+
+    // Older than any recorded frame clamps to the oldest
+    const HighResTimeT ancient = {.nanoseconds = -5LL * 1000 * 1000};
+    ASSERT_TRUE(TmMapTimestampToTick(tm, ancient).tick == 0);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+static int test_map_timestamp_after_fast_forward_and_restore(void)
+{
+    // 100 Hz; frames at 0 and 20ms run ticks 0 and 1
+    static const long long script[] = {0LL, 0LL, 20LL * 1000 * 1000};
+    set_script(script, sizeof(script) / sizeof(script[0]));
+
+    TimeManager* tm = TmCreate(NULL);
+    TmSetPhysicsHz(tm, 100);
+    TmSetTimeSource(tm, fake_now_script);
+    (void)TmBeginFrame(tm);
+    (void)TmBeginFrame(tm);
+    TmTimingState state;
+    TmSaveTimingState(tm, &state);
+
+    // Fast-forward runs ticks 2..4 at the frame's wall time
+    BatchCounter counter = {0};
+    ASSERT_EQ_SIZE(TmFastForward(tm, 0.03, 0, count_batch, &counter), 3);
+    const HighResTimeT after = {.nanoseconds = 21LL * 1000 * 1000};
+    TmTickPosition p = TmMapTimestampToTick(tm, after);
+    ASSERT_TRUE(p.tick == 5);
+    ASSERT_NEAR(p.fraction, 0.1, 1e-6);
+
+    // Timestamps inside the frame still land on the frame's own steps
+    const HighResTimeT during = {.nanoseconds = 15LL * 1000 * 1000};
+    p = TmMapTimestampToTick(tm, during);
+    ASSERT_TRUE(p.tick == 1);
+    ASSERT_NEAR(p.fraction, 0.5, 1e-6);
+
+    // Headless steps move the anchor the same way
+    (void)TmAdvanceSteps(tm, 2);
+    ASSERT_TRUE(TmMapTimestampToTick(tm, after).tick == 7);
+
+    // Rolled back to tick 2: nothing maps onto the discarded ticks
+    TmRestoreTimingState(tm, &state);
+    p = TmMapTimestampToTick(tm, after);
+    ASSERT_TRUE(p.tick == 2);
+    ASSERT_NEAR(p.fraction, 0.1, 1e-6);
+    ASSERT_TRUE(TmMapTimestampToTick(tm, during).tick == 2);
+
+    TmDestroy(tm);
+    return 0;
+}
+
+#if TM_STATS_LEVEL >= TM_STATS_HISTOGRAM
+static int test_phase_profiler(void)
+{
+    // Steady clock with a zero step, moved by hand
+    set_steady(0, 0);
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now_steady);
+    (void)TmBeginFrame(tm);
+
+    // No phases marked: the frame costs nothing in any phase
+    g_cur_ns = 16LL * 1000 * 1000;
+    FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_TRUE(f.phaseBudgetExceeded == 0);
+    ASSERT_NEAR(TmGetPhaseStats(tm, TM_PHASE_SIM).average, 0.0, 0.0);
+
+    TmSetPhaseBudget(tm, TM_PHASE_SIM, 0.004);
+    TmSetPhaseBudget(tm, TM_PHASE_PRESENT, 0.002);
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        // Input 1ms, sim 3ms (5ms in the last frame), sim entered twice, render 2ms
+        TmPhaseBegin(tm, TM_PHASE_INPUT);
+        g_cur_ns += 1000000;
+        TmPhaseEnd(tm, TM_PHASE_INPUT);
+        TmPhaseBegin(tm, TM_PHASE_SIM);
+        g_cur_ns += frame == 3 ? 4000000 : 2000000;
+        TmPhaseEnd(tm, TM_PHASE_SIM);
+        TmPhaseBegin(tm, TM_PHASE_SIM);
+        g_cur_ns += 1000000;
+        TmPhaseEnd(tm, TM_PHASE_SIM);
+        TmPhaseBegin(tm, TM_PHASE_RENDER_SUBMIT);
+        g_cur_ns += 2000000;
+        TmPhaseEnd(tm, TM_PHASE_RENDER_SUBMIT);
+        TmPhaseEnd(tm, TM_PHASE_ANIMATION); // never begun: ignored
+        g_cur_ns += 10000000;
+        f = TmBeginFrame(tm);
+        ASSERT_TRUE(f.phaseBudgetExceeded == (frame == 3 ? (1u << TM_PHASE_SIM) : 0u));
+    }
+
+    // The unmarked frame counts as zero in the averages
+    TmPhaseStats sim = TmGetPhaseStats(tm, TM_PHASE_SIM);
+    ASSERT_NEAR(sim.last, 0.005, 1e-12);
+    ASSERT_NEAR(sim.average, 0.0028, 1e-12);
+    ASSERT_NEAR(sim.max, 0.005, 1e-12);
+    ASSERT_NEAR(sim.budget, 0.004, 0.0);
+    ASSERT_EQ_SIZE(sim.overBudgetFrames, 1);
+    ASSERT_NEAR(TmGetPhaseStats(tm, TM_PHASE_INPUT).average, 0.0008, 1e-12);
+    ASSERT_NEAR(TmGetPhaseStats(tm, TM_PHASE_ANIMATION).max, 0.0, 0.0);
+
+    // Present waits across the frame boundary: split between the two frames
+    TmPhaseBegin(tm, TM_PHASE_PRESENT);
+    g_cur_ns += 3000000;
+    f = TmBeginFrame(tm);
+    ASSERT_TRUE(f.phaseBudgetExceeded == (1u << TM_PHASE_PRESENT));
+    g_cur_ns += 1000000;
+    TmPhaseEnd(tm, TM_PHASE_PRESENT);
+    g_cur_ns += 15000000;
+    f = TmBeginFrame(tm);
+    ASSERT_TRUE(f.phaseBudgetExceeded == 0);
+    ASSERT_NEAR(TmGetPhaseStats(tm, TM_PHASE_PRESENT).last, 0.001, 1e-12);
+
+    // Phases stop being marked: last drops to zero instead of repeating the previous frame
+    g_cur_ns += 16000000;
+    f = TmBeginFrame(tm);
+    ASSERT_TRUE(f.phaseBudgetExceeded == 0);
+    for (int phase = 0; phase < TM_PHASE_COUNT; ++phase)
+    {
+        ASSERT_NEAR(TmGetPhaseStats(tm, (TmFramePhase)phase).last, 0.0, 0.0);
+    }
+
+    // Reset clears the statistics and any open phase but keeps the budgets
+    TmPhaseBegin(tm, TM_PHASE_SIM);
+    g_cur_ns += 8000000;
+    TmReset(tm);
+    sim = TmGetPhaseStats(tm, TM_PHASE_SIM);
+    ASSERT_NEAR(sim.average, 0.0, 0.0);
+    ASSERT_NEAR(sim.max, 0.0, 0.0);
+    ASSERT_EQ_SIZE(sim.overBudgetFrames, 0);
+    ASSERT_NEAR(sim.budget, 0.004, 0.0);
+    (void)TmBeginFrame(tm);
+    g_cur_ns += 16000000;
+    f = TmBeginFrame(tm);
+    ASSERT_TRUE(f.phaseBudgetExceeded == 0);
+    ASSERT_NEAR(TmGetPhaseStats(tm, TM_PHASE_SIM).last, 0.0, 0.0);
+
+    TmDestroy(tm);
+    return 0;
+}
+#endif
+
+static int test_present_tracking(void)
+{
+    set_steady(0, 0);
+    TimeManager* tm = TmCreate(NULL);
+    TmSetTimeSource(tm, fake_now_steady);
+    TmSetRefreshPeriod(tm, 1.0 / 60.0, 1);
+
+    // 60 Hz cadence with one missed vsync (image repeated) and a present under half a refresh later
+    const long long presents[] = {0, 16666667, 33333333, 66666667, 70000000, 83333333};
+    for (size_t i = 0; i < sizeof(presents) / sizeof(presents[0]); ++i)
+    {
+        const HighResTimeT t = {.nanoseconds = presents[i]};
+        TmMarkPresentAt(tm, t);
+    }
+
+    // Out-of-order timestamps are ignored
+    const HighResTimeT stale = {.nanoseconds = 50000000};
+    TmMarkPresentAt(tm, stale);
+
+    TmPresentStats stats = TmGetPresentStats(tm);
+    ASSERT_EQ_SIZE(stats.presents, 6);
+    ASSERT_EQ_SIZE(stats.repeatedRefreshes, 1);
+    ASSERT_EQ_SIZE(stats.earlyPresents, 1);
+    ASSERT_NEAR(stats.maxInterval, 0.0333333, 1e-6);
+    ASSERT_NEAR(stats.lastInterval, 0.0133333, 1e-6);
+
+    // Reported next to rawFrameTime, which here sees a steady 16ms
+    g_cur_ns = 83333333;
+    (void)TmBeginFrame(tm);
+    g_cur_ns = 100000000;
+    TmMarkPresent(tm);
+    FrameTimingData f = TmBeginFrame(tm);
+    ASSERT_NEAR(f.presentInterval, 0.0166667, 1e-6);
+    ASSERT_EQ_SIZE(f.presentRefreshes, 1);
+    ASSERT_NEAR(f.rawFrameTime, 0.0166667, 1e-6);
+
+    // Without a refresh period only intervals are tracked
+    TmSetRefreshPeriod(tm, 0.0, 1);
+    g_cur_ns = 150000000;
+    TmMarkPresent(tm);
+    f = TmBeginFrame(tm);
+    ASSERT_NEAR(f.presentInterval, 0.05, 1e-9);
+    ASSERT_EQ_SIZE(f.presentRefreshes, 0);
+    ASSERT_EQ_SIZE(TmGetPresentStats(tm).repeatedRefreshes, 1);
+
+    // Reset starts over: the next present is a first present, not an interval from before the reset
+    TmSetRefreshPeriod(tm, 1.0 / 60.0, 1);
+    TmReset(tm);
+    ASSERT_EQ_SIZE(TmGetPresentStats(tm).presents, 0);
+    g_cur_ns = 400000000;
+    TmMarkPresent(tm);
+    (void)TmBeginFrame(tm);
+    g_cur_ns = 416666667;
+    f = TmBeginFrame(tm);
+    ASSERT_NEAR(f.presentInterval, 0.0, 0.0);
+    ASSERT_EQ_SIZE(f.presentRefreshes, 0);
+    stats = TmGetPresentStats(tm);
+    ASSERT_EQ_SIZE(stats.presents, 1);
+    ASSERT_EQ_SIZE(stats.repeatedRefreshes, 0);
+    ASSERT_NEAR(stats.maxInterval, 0.0, 0.0);
+
+    TmDestroy(tm);
+    return 0;
+}
 
 int main(void)
 {
@@ -292,7 +1072,45 @@ int main(void)
         return rc;
     if ((rc = test_pause_resume()))
         return rc;
+#if TM_STATS_LEVEL >= TM_STATS_BASIC
     if ((rc = test_average_fps()))
         return rc;
+#endif
+    if ((rc = test_headless_advance()))
+        return rc;
+    if ((rc = test_headless_matches_realtime()))
+        return rc;
+    if ((rc = test_fast_forward()))
+        return rc;
+    if ((rc = test_dropped_time_from_step_clamp()))
+        return rc;
+    if ((rc = test_substeps()))
+        return rc;
+    if ((rc = test_extrapolation_mode()))
+        return rc;
+    if ((rc = test_extrapolate_positions()))
+        return rc;
+    if ((rc = test_latched_timing()))
+        return rc;
+    if ((rc = test_timing_state_save_restore()))
+        return rc;
+    if ((rc = test_timing_state_serialization()))
+        return rc;
+    if ((rc = test_tick_and_sim_clock()))
+        return rc;
+    if ((rc = test_run_ahead()))
+        return rc;
+    if ((rc = test_resimulate()))
+        return rc;
+    if ((rc = test_map_timestamp_to_tick()))
+        return rc;
+    if ((rc = test_map_timestamp_after_fast_forward_and_restore()))
+        return rc;
+#if TM_STATS_LEVEL >= TM_STATS_HISTOGRAM
+    if ((rc = test_phase_profiler()))
+        return rc;
+#endif
+    if ((rc = test_present_tracking()))
+        return rc;
     return 0;
 }
@@ -0,0 +1,156 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "time_manager/trace_exporter.h"
+#include "test_helpers.h"
+
+static const char* TRACE_PATH = "test_trace_exporter.json";
+
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+static long long g_cur_ns = 0;
+
+static HighResTimeT fake_now(void)
+{
+    HighResTimeT t;
+    t.nanoseconds = g_cur_ns;
+    return t;
+}
+#endif
+
+// Reads the whole trace file; the caller frees the result
+static char* read_trace(void)
+{
+    FILE* file = fopen(TRACE_PATH, "rb");
+    if (!file)
+    {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = malloc((size_t)size + 1);
+    if (text)
+    {
+        text[fread(text, 1, (size_t)size, file)] = '\0';
+    }
+    fclose(file);
+    return text;
+}
+
+static size_t count(const char* text, const char* needle)
+{
+    size_t n = 0;
+    for (const char* p = strstr(text, needle); p; p = strstr(p + 1, needle))
+    {
+        n++;
+    }
+    return n;
+}
+
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+static int test_frame_timeline(void)
+{
+    TimeManager* tm = TmCreate(NULL);
+    const TmTraceExporterConfig cfg = TmTraceExporterDefaultConfig(TRACE_PATH);
+    TmTraceExporter* exporter = TmTraceExporterCreate(&cfg);
+    ASSERT_TRUE(tm != NULL && exporter != NULL);
+    g_cur_ns = 1000000000LL;
+    TmSetTimeSource(tm, fake_now);
+    TmAttachTraceExporter(tm, exporter);
+
+    (void)TmBeginFrame(tm);
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        TmPhaseBegin(tm, TM_PHASE_SIM);
+        g_cur_ns += 2000000LL;
+        TmTraceExporterRecordStep(exporter, TmGetTick(tm), g_cur_ns - 1000000LL, g_cur_ns);
+        TmPhaseEnd(tm, TM_PHASE_SIM);
+        if (frame == 10)
+        {
+            TmSetTimeScale(tm, 0.5);
+        }
+        // One long frame makes the simulation lag
+        g_cur_ns += frame == 14 ? 300000000LL : 14000000LL;
+        (void)TmBeginFrame(tm);
+    }
+    // Reset puts the time scale back to 1.0, which shows on the counter
+    TmReset(tm);
+    TmAttachTraceExporter(tm, NULL);
+
+    const TmTraceStats stats = TmTraceExporterGetStats(exporter);
+    ASSERT_EQ_SIZE(stats.dropped, 0);
+    // 20 frames, 20 phases, 20 steps, 1.0, 0.5 and 1.0 time scale, lagging 0, 1 and back to 0
+    ASSERT_EQ_SIZE(stats.recorded, 66);
+    TmTraceExporterDestroy(exporter);
+    TmDestroy(tm);
+
+    char* text = read_trace();
+    ASSERT_TRUE(text != NULL);
+    ASSERT_TRUE(text[0] == '[');
+    ASSERT_TRUE(strstr(text, "\n]\n") != NULL);
+    ASSERT_EQ_SIZE(count(text, "\"name\":\"Frame\""), 20);
+    ASSERT_EQ_SIZE(count(text, "\"name\":\"Simulation\""), 20);
+    ASSERT_EQ_SIZE(count(text, "\"name\":\"Step\""), 20);
+    ASSERT_EQ_SIZE(count(text, "\"name\":\"TimeScale\""), 3);
+    ASSERT_EQ_SIZE(count(text, "\"name\":\"Lagging\""), 3);
+    ASSERT_EQ_SIZE(count(text, "\"lagging\":true"), 1);
+    ASSERT_TRUE(strstr(text, "\"timeScale\":0.5") != NULL);
+    // First frame: 1.000000s to 1.016000s, in microseconds
+    ASSERT_TRUE(strstr(text, "\"ts\":1000000.000,\"dur\":16000.000") != NULL);
+    free(text);
+    remove(TRACE_PATH);
+    return 0;
+}
+#endif
+
+static int test_drops_when_full(void)
+{
+    TmTraceExporterConfig cfg = TmTraceExporterDefaultConfig(TRACE_PATH);
+    cfg.capacity = 5; // rounded up to 8
+    cfg.flushInterval = 200;
+    TmTraceExporter* exporter = TmTraceExporterCreate(&cfg);
+    ASSERT_TRUE(exporter != NULL);
+
+    // The writer drains at most once before sleeping, so most of these cannot fit
+    for (int i = 0; i < 100; ++i)
+    {
+        TmTraceExporterRecordStep(exporter, (uint64_t)i, i * 1000LL, i * 1000LL + 500);
+    }
+    const TmTraceStats stats = TmTraceExporterGetStats(exporter);
+    ASSERT_EQ_SIZE(stats.recorded, 100);
+    ASSERT_TRUE(stats.dropped >= 100 - 16);
+    TmTraceExporterDestroy(exporter);
+
+    char* text = read_trace();
+    ASSERT_TRUE(text != NULL);
+    ASSERT_EQ_SIZE(count(text, "\"name\":\"Step\""), 100 - stats.dropped);
+    free(text);
+    remove(TRACE_PATH);
+    return 0;
+}
+
+static int test_invalid_config(void)
+{
+    TmTraceExporterConfig cfg = TmTraceExporterDefaultConfig(TRACE_PATH);
+    cfg.capacity = 0;
+    ASSERT_TRUE(TmTraceExporterCreate(&cfg) == NULL);
+    cfg = TmTraceExporterDefaultConfig("no_such_directory/trace.json");
+    ASSERT_TRUE(TmTraceExporterCreate(&cfg) == NULL);
+    TmTraceExporterDestroy(NULL);
+    return 0;
+}
+
+int main(void)
+{
+    int rc = 0;
+#if TM_STATS_LEVEL >= TM_STATS_TRACING
+    if ((rc = test_frame_timeline()))
+        return rc;
+#endif
+    if ((rc = test_drops_when_full()))
+        return rc;
+    if ((rc = test_invalid_config()))
+        return rc;
+    return 0;
+}